@@ -0,0 +1,60 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Allocations.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+//Every block starts with its size, so delete knows how much it gives back. The array and nothrow forms
+//aren't replaced since they go through these by default
+static constexpr std::size_t header = alignof(std::max_align_t);
+
+void* operator new(std::size_t size)
+{
+    char* block = static_cast<char*>(std::malloc(size + header));
+    if(block == nullptr)
+        throw std::bad_alloc();
+
+    std::memcpy(block, &size, sizeof(size));
+    Allocations::Allocated(size);
+    return block + header;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if(pointer == nullptr)
+        return;
+
+    char* block = static_cast<char*>(pointer) - header;
+    std::size_t size;
+    std::memcpy(&size, block, sizeof(size));
+    Allocations::Freed(size);
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
@@ -0,0 +1,59 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+//Counts what goes through the global operator new and delete, which Allocations.cpp replaces for the whole benchmark executable
+class Allocations
+{
+public:
+    //Allocations made so far
+    static std::size_t Count()
+    {
+        return count;
+    }
+
+    //Bytes asked for and not given back yet
+    static std::size_t LiveBytes()
+    {
+        return liveBytes;
+    }
+
+    static void Allocated(std::size_t size)
+    {
+        count++;
+        liveBytes += size;
+    }
+
+    static void Freed(std::size_t size)
+    {
+        liveBytes -= size;
+    }
+
+private:
+    static inline std::atomic<std::size_t> count{ 0 };
+    static inline std::atomic<std::size_t> liveBytes{ 0 };
+};
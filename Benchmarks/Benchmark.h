@@ -0,0 +1,94 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+//Harness for the benchmarks, which are kept out of Test Project so its asserts stay quick.
+//Every benchmark is a function registered under a name with REGISTER_BENCHMARK that prints its own table,
+//main runs all of them or only the ones named on the command line
+class Benchmark
+{
+public:
+    using Function = void(*)();
+
+    struct Entry
+    {
+        std::string_view name;
+        Function function;
+    };
+
+public:
+    static bool Register(std::string_view name, Function function)
+    {
+        Entries().push_back(Entry{ name, function });
+        return true;
+    }
+
+    //Sorted by name, registration order depends on the order files are linked in
+    static std::vector<Entry> All()
+    {
+        std::vector<Entry> entries = Entries();
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+        return entries;
+    }
+
+    //Fastest of runs calls to function, which does count things each call, in nanoseconds per thing
+    template<class F>
+    static double NanosecondsPer(std::size_t count, F&& function, int runs = 5)
+    {
+        double best = std::numeric_limits<double>::max();
+        for(int i = 0; i < runs; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count() / static_cast<double>(count));
+        }
+
+        return best;
+    }
+
+    //Keeps the optimizer from dropping work whose result nothing else reads
+    static void Keep(std::size_t value)
+    {
+        sink = sink + value;
+    }
+
+private:
+    static std::vector<Entry>& Entries()
+    {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    static inline volatile std::size_t sink = 0;
+};
+
+#define REGISTER_BENCHMARK(name) static void name(); static const bool name##Registered = Benchmark::Register(#name, name); static void name()
@@ -0,0 +1,79 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "../Test Project/JsonSerializer.h"
+#include "../Test Project/BinarySerializer.h"
+#include "../Test Project/Bar.h"
+#include <cstdio>
+#include <string>
+
+//Writes every bar under its own name and dumps them, then reads them back in the same order.
+//Prints ns per object for each and the dump's size
+template<class SerializerT, class Make, class Rewind>
+static void MeasureThroughput(const char* label, const std::vector<std::string>& names, const std::vector<Bar>& bars, Make&& make, Rewind&& rewind)
+{
+    SerializerT serializer = make();
+    std::size_t size = 0;
+    double write = Benchmark::NanosecondsPer(bars.size(), [&]
+    {
+        serializer = make();
+        for(std::size_t i = 0; i < bars.size(); i++)
+            serializer.Serialize(names[i], bars[i]);
+        size = serializer.Dump().size();
+    });
+
+    double read = Benchmark::NanosecondsPer(bars.size(), [&]
+    {
+        rewind(serializer);
+        Bar bar;
+        for(const std::string& name : names)
+        {
+            serializer.Deserialize(name, bar);
+            Benchmark::Keep(bar.y);
+        }
+    });
+
+    std::printf("%-20s %10.0f ns %8.0f ns %7.1f MB\n", label, write, read, size / (1024.0 * 1024.0));
+}
+
+REGISTER_BENCHMARK(BinaryThroughput)
+{
+    constexpr std::size_t count = 200000;
+    std::vector<std::string> names;
+    std::vector<Bar> bars(count);
+    for(std::size_t i = 0; i < count; i++)
+    {
+        names.push_back("bar" + std::to_string(i));
+        bars[i].x = static_cast<int>(i);
+        bars[i].y = static_cast<int>(i * 3);
+    }
+
+    auto rewind = [](BinarySerializer& serializer) { serializer.Rewind(); };
+
+    std::printf("%-20s %13s %11s %10s\n", "", "write+dump", "read", "size");
+    MeasureThroughput<JsonSerializer>("JsonSerializer", names, bars, [] { return JsonSerializer(); }, [](JsonSerializer&) {});
+    MeasureThroughput<BinarySerializer>("Binary Positional", names, bars, [] { return BinarySerializer(BinarySerializer::Mode::Positional); }, rewind);
+    MeasureThroughput<BinarySerializer>("Binary Named", names, bars, [] { return BinarySerializer(BinarySerializer::Mode::Named); }, rewind);
+}
@@ -0,0 +1,81 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "../Test Project/JsonSerializer.h"
+#include "../Test Project/BinarySerializer.h"
+#include "../Test Project/BlockCompressor.h"
+#include "../Test Project/Bar.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+
+//Size and ratio of the compressed dump, and MB of the uncompressed dump per second each way
+static void MeasureCompression(const char* label, const std::string& dump, double dumpMs)
+{
+    BlockCompressor<> compressor;
+    std::string packed;
+    double compressNs = Benchmark::NanosecondsPer(dump.size(), [&] { packed = compressor.Compress(dump); });
+    double decompressNs = Benchmark::NanosecondsPer(dump.size(), [&] { Benchmark::Keep(compressor.Decompress(packed).size()); });
+
+    constexpr double megabyte = 1024.0 * 1024.0;
+    std::printf("%-20s %7.1f MB %6.2f %8.0f MB/s %10.0f MB/s %8.0f ms\n", label, dump.size() / megabyte, static_cast<double>(dump.size()) / packed.size(),
+                1e9 / (compressNs * megabyte), 1e9 / (decompressNs * megabyte), dumpMs);
+}
+
+//1M Bar records through the binary serializer, 250K polymorphic ones through JSON, in 64KB blocks on every core
+REGISTER_BENCHMARK(BlockCompression)
+{
+    constexpr std::size_t count = 1000000;
+    std::vector<Bar> bars(count);
+    for(std::size_t i = 0; i < count; i++)
+    {
+        bars[i].x = static_cast<int>(i);
+        bars[i].y = static_cast<int>(i % 1000);
+    }
+
+    std::printf("%-20s %10s %6s %13s %15s %11s\n", "dump", "size", "ratio", "compress", "decompress", "Dump()");
+
+    for(auto mode : { BinarySerializer::Mode::Positional, BinarySerializer::Mode::Named })
+    {
+        BinarySerializer binary(mode);
+        for(const Bar& bar : bars)
+            binary.Serialize("bar", bar);
+
+        std::string dump;
+        double dumpMs = Benchmark::NanosecondsPer(1, [&] { dump = binary.Dump(); }) * 1e-6;
+        MeasureCompression((mode == BinarySerializer::Mode::Positional) ? "Binary, positional" : "Binary, named", dump, dumpMs);
+    }
+
+    JsonSerializer json;
+    for(std::size_t i = 0; i < count / 4; i++)
+    {
+        const Foo* foo = &bars[i];
+        json.PolySerialize<Foo>("bar" + std::to_string(i), foo);
+    }
+
+    std::string dump;
+    double dumpMs = Benchmark::NanosecondsPer(1, [&] { dump = json.Dump(); }) * 1e-6;
+    MeasureCompression("JSON", dump, dumpMs);
+}
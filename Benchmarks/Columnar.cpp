@@ -0,0 +1,118 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "../Test Project/BinarySerializer.h"
+#include "../Test Project/ColumnarSerializer.h"
+#include <cstdio>
+
+namespace
+{
+    struct Sample
+    {
+        std::int64_t timestamp;
+        int small;
+        double value;
+    };
+}
+
+template<class SerializerT>
+struct SerializeConstruct<Sample, SerializerT>
+{
+    using value_type = Sample;
+    using pointer = Sample*;
+    using reference = Sample&;
+
+    using const_pointer = const Sample*;
+    using const_reference = const Sample&;
+
+    using serializer_type = SerializerT;
+
+    static constexpr std::size_t field_count = 3;
+
+    static void Serialize(serializer_type& serializer, const_reference& v)
+    {
+        serializer.Serialize("timestamp", v.timestamp);
+        serializer.Serialize("small", v.small);
+        serializer.Serialize("value", v.value);
+    }
+
+    static void Deserialize(serializer_type& serializer, reference& v)
+    {
+        serializer.Deserialize("timestamp", v.timestamp);
+        serializer.Deserialize("small", v.small);
+        serializer.Deserialize("value", v.value);
+    }
+};
+
+//Timestamps which mostly tick by one, small ints and doubles, record by record against a column per field
+REGISTER_BENCHMARK(Columnar)
+{
+    constexpr std::size_t count = 1000000;
+    std::vector<Sample> samples(count);
+    for(std::size_t i = 0; i < count; i++)
+        samples[i] = Sample{ 1600000000000 + static_cast<std::int64_t>(i) + static_cast<std::int64_t>(i % 7 == 0), static_cast<int>(i % 100), i * 0.25 };
+
+    std::vector<Sample> read;
+    std::printf("%-10s %12s %12s %16s\n", "", "write", "read", "bytes/record");
+
+    BinarySerializer binary;
+    double binaryWrite = Benchmark::NanosecondsPer(count, [&]
+    {
+        binary = BinarySerializer();
+        binary.Serialize("samples", samples);
+    });
+    double binaryRead = Benchmark::NanosecondsPer(count, [&]
+    {
+        binary.Rewind();
+        binary.Deserialize("samples", read);
+        Benchmark::Keep(read.size());
+    });
+    std::printf("%-10s %9.1f ns %9.1f ns %16.1f\n", "binary", binaryWrite, binaryRead, static_cast<double>(binary.Dump().size()) / count);
+
+    ColumnarSerializer columnar;
+    double columnarWrite = Benchmark::NanosecondsPer(count, [&]
+    {
+        columnar = ColumnarSerializer();
+        columnar.SerializeRecords("samples", samples);
+    });
+    double columnarRead = Benchmark::NanosecondsPer(count, [&]
+    {
+        columnar.Rewind();
+        columnar.DeserializeRecords("samples", read);
+        Benchmark::Keep(read.size());
+    });
+    std::printf("%-10s %9.1f ns %9.1f ns %16.1f\n", "columnar", columnarWrite, columnarRead, static_cast<double>(columnar.Dump().size()) / count);
+
+    std::vector<std::int64_t> timestamps;
+    std::vector<int> smalls;
+    std::vector<double> values;
+    double columns = Benchmark::NanosecondsPer(count * 3, [&]
+    {
+        columnar.Rewind();
+        columnar.DeserializeColumns("samples", "timestamp", timestamps, "small", smalls, "value", values);
+        Benchmark::Keep(timestamps.size());
+    });
+    std::printf("DeserializeColumns %.2f ns per value\n", columns);
+}
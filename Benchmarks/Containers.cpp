@@ -0,0 +1,115 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "../Test Project/JsonSerializer.h"
+#include "../Test Project/BinarySerializer.h"
+#include "../Test Project/MsgPackSerializer.h"
+#include "../Test Project/CborSerializer.h"
+#include "../Test Project/ZeroCopySerializer.h"
+#include "../Test Project/ColumnarSerializer.h"
+#include "../Test Project/Bar.h"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <limits>
+#include <list>
+
+static constexpr std::size_t elements = 1000000;
+
+static void Destroy(std::list<Bar*>& values)
+{
+    //The reader made every element as exactly a Bar, delete can't know that since Foo's destructor isn't virtual
+    for(Bar* value : values)
+    {
+        value->~Bar();
+        ::operator delete(value);
+    }
+    values.clear();
+}
+
+template<class T>
+static void Destroy(T&)
+{
+}
+
+//Millions of elements per second written and read back. Every read starts from a fresh reader, which isn't timed
+template<class SerializerT, class Container, class Reopen>
+static std::pair<double, double> MeasureContainer(const Container& values, Reopen&& reopen)
+{
+    SerializerT writer;
+    double writeNs = Benchmark::NanosecondsPer(elements, [&]
+    {
+        writer = SerializerT();
+        writer.Serialize("values", values);
+    }, 3);
+
+    double readNs = std::numeric_limits<double>::max();
+    for(int run = 0; run < 3; run++)
+    {
+        SerializerT reader = reopen(writer);
+        Container read;
+        readNs = std::min(readNs, Benchmark::NanosecondsPer(elements, [&] { reader.Deserialize("values", read); }, 1));
+        Benchmark::Keep(read.size());
+        Destroy(read);
+    }
+
+    return { 1e3 / writeNs, 1e3 / readNs };
+}
+
+template<class SerializerT, class Reopen>
+static void MeasureSerializer(const char* label, const std::vector<Bar>& vector, const std::deque<Bar>& deque, const std::list<Bar*>& list, Reopen&& reopen)
+{
+    auto [vectorWrite, vectorRead] = MeasureContainer<SerializerT>(vector, reopen);
+    auto [dequeWrite, dequeRead] = MeasureContainer<SerializerT>(deque, reopen);
+    auto [listWrite, listRead] = MeasureContainer<SerializerT>(list, reopen);
+    std::printf("%-10s %6.1f %6.1f %7.1f %6.1f %7.1f %6.1f\n", label, vectorWrite, vectorRead, dequeWrite, dequeRead, listWrite, listRead);
+}
+
+//1M Bars in each container through every serializer, in millions of elements per second on one thread.
+//Reading list<Bar*> is mostly allocating one Bar per element
+REGISTER_BENCHMARK(Containers)
+{
+    std::vector<Bar> vector(elements);
+    for(std::size_t i = 0; i < elements; i++)
+    {
+        vector[i].x = static_cast<int>(i);
+        vector[i].y = static_cast<int>(i % 1000);
+    }
+    std::deque<Bar> deque(vector.begin(), vector.end());
+    std::list<Bar*> list;
+    for(Bar& bar : vector)
+        list.push_back(&bar);
+
+    auto same = [](auto& writer) { return writer; };
+
+    std::printf("%-10s %13s %14s %14s\n", "", "vector<Bar>", "deque<Bar>", "list<Bar*>");
+    std::printf("%-10s %6s %6s %7s %6s %7s %6s\n", "", "write", "read", "write", "read", "write", "read");
+    MeasureSerializer<BinarySerializer>("Binary", vector, deque, list, same);
+    MeasureSerializer<MsgPackSerializer>("MsgPack", vector, deque, list, same);
+    MeasureSerializer<CborSerializer>("Cbor", vector, deque, list, same);
+    MeasureSerializer<ZeroCopySerializer>("ZeroCopy", vector, deque, list, [](ZeroCopySerializer& writer) { return ZeroCopySerializer::Parse(writer.Dump()); });
+    MeasureSerializer<ColumnarSerializer>("Columnar", vector, deque, list, same);
+    MeasureSerializer<JsonSerializer>("Json", vector, deque, list, same);
+}
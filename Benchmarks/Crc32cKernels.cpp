@@ -0,0 +1,99 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "../Test Project/BinarySerializer.h"
+#include "../Test Project/RecordStream.h"
+#include "../Test Project/Bar.h"
+#include <cstdio>
+#include <random>
+#include <string>
+
+//A named mode record of a few Bars, about the size of a typical log entry
+static BinarySerializer MakeRecord(int seed)
+{
+    BinarySerializer record(BinarySerializer::Mode::Named);
+    for(int i = 0; i < 5; i++)
+    {
+        Bar bar;
+        bar.x = seed + i;
+        bar.y = seed * i;
+        record.Serialize("bar" + std::to_string(i), bar);
+    }
+    return record;
+}
+
+//Throughput of every checksum kernel this machine has, and what framing costs next to serializing a record
+REGISTER_BENCHMARK(Crc32cKernels)
+{
+    std::string buffer(1024 * 1024, '\0');
+    std::mt19937 random(42);
+    for(char& c : buffer)
+        c = static_cast<char>(random());
+
+    std::string payload = MakeRecord(1).Dump();
+    double serializeNs = Benchmark::NanosecondsPer(10000, [&]
+    {
+        for(int i = 0; i < 10000; i++)
+            Benchmark::Keep(MakeRecord(i).Dump().size());
+    });
+
+    std::string log;
+    for(int i = 0; i < 10000; i++)
+        log += RecordWriter::Frame(MakeRecord(i).Dump());
+
+    std::printf("%zu byte records, %.0f ns each to serialize and dump\n", payload.size(), serializeNs);
+    std::printf("%-10s %12s %18s %12s %14s\n", "kernel", "1MB buffer", "CRC per record", "share", "read frame");
+
+    Crc32c::Kernel selected = Crc32c::SelectedKernel();
+    for(auto [kernel, label] : { std::pair(Crc32c::Kernel::Sse42, "SSE4.2"), std::pair(Crc32c::Kernel::Slicing8, "slicing") })
+    {
+        if(!Crc32c::Select(kernel))
+            continue;
+
+        double bufferNs = Benchmark::NanosecondsPer(buffer.size(), [&] { Benchmark::Keep(Crc32c::Compute(buffer.data(), buffer.size())); });
+
+        //Both checksums in a frame's header, the payload's and the header's own
+        char header[12] = {};
+        double recordNs = Benchmark::NanosecondsPer(10000, [&]
+        {
+            for(int i = 0; i < 10000; i++)
+            {
+                header[0] = static_cast<char>(i);
+                Benchmark::Keep(Crc32c::Compute(payload.data(), payload.size()) + Crc32c::Compute(header, sizeof(header)));
+            }
+        });
+
+        double readNs = Benchmark::NanosecondsPer(10000, [&]
+        {
+            RecordReader reader(log);
+            std::string_view frame;
+            while(reader.Next(frame))
+                Benchmark::Keep(frame.size());
+        });
+
+        std::printf("%-10s %7.1f GB/s %15.0f ns %11.0f%% %11.0f ns\n", label, 1.0 / bufferNs, recordNs, 100.0 * recordNs / serializeNs, readNs);
+    }
+    Crc32c::Select(selected);
+}
@@ -0,0 +1,119 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "Allocations.h"
+#include "../Test Project/JsonSerializer.h"
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    //An object with width int fields, f0, f1 and so on
+    struct Wide
+    {
+        int width;
+        int values[32];
+    };
+
+    const std::string& FieldName(int i)
+    {
+        static const std::vector<std::string> names = []
+        {
+            std::vector<std::string> names;
+            for(int j = 0; j < 32; j++)
+                names.push_back("f" + std::to_string(j));
+            return names;
+        }();
+        return names[i];
+    }
+}
+
+template<class SerializerT>
+struct SerializeConstruct<Wide, SerializerT>
+{
+    using value_type = Wide;
+    using pointer = Wide*;
+    using reference = Wide&;
+
+    using const_pointer = const Wide*;
+    using const_reference = const Wide&;
+
+    using serializer_type = SerializerT;
+
+    static void Serialize(serializer_type& serializer, const_reference& v)
+    {
+        for(int i = 0; i < v.width; i++)
+            serializer.Serialize(FieldName(i), v.values[i]);
+    }
+
+    static void Deserialize(serializer_type& serializer, reference& v)
+    {
+        for(int i = 0; i < v.width; i++)
+            serializer.Deserialize(FieldName(i), v.values[i]);
+    }
+};
+
+//Live bytes per object, counting its entry in the parent, and the time to look up one of its fields
+template<class SerializerT>
+static std::pair<double, double> MeasureObjects(int width)
+{
+    constexpr std::size_t objects = 20000;
+    std::vector<std::string> names;
+    for(std::size_t i = 0; i < objects; i++)
+        names.push_back("o" + std::to_string(i));
+
+    Wide wide{ width, {} };
+    for(int i = 0; i < width; i++)
+        wide.values[i] = i;
+
+    std::size_t before = Allocations::LiveBytes();
+    SerializerT serializer;
+    for(const std::string& name : names)
+        serializer.Serialize(name, wide);
+    double bytes = static_cast<double>(Allocations::LiveBytes() - before) / objects;
+
+    double ns = Benchmark::NanosecondsPer(objects * width, [&]
+    {
+        Wide read{ width, {} };
+        for(const std::string& name : names)
+        {
+            serializer.Deserialize(name, read);
+            Benchmark::Keep(read.values[width - 1]);
+        }
+    });
+
+    return { bytes, ns };
+}
+
+REGISTER_BENCHMARK(FlatMapObjects)
+{
+    std::printf("%6s %14s %14s %14s %14s\n", "width", "std::map B", "FlatMap B", "std::map ns", "FlatMap ns");
+    for(int width : { 1, 2, 4, 8, 32 })
+    {
+        auto [mapBytes, mapNs] = MeasureObjects<JsonSerializer>(width);
+        auto [flatBytes, flatNs] = MeasureObjects<FlatJsonSerializer>(width);
+        std::printf("%6d %14.0f %14.0f %14.1f %14.1f\n", width, mapBytes, flatBytes, mapNs, flatNs);
+    }
+}
@@ -0,0 +1,64 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "Allocations.h"
+#include "../Test Project/JsonSerializer.h"
+#include <cstdio>
+#include <string>
+
+//Allocations per field for names which fit in std::string's small buffer and ones which don't.
+//Reading or overwriting a field allocates nothing, writing a new one allocates its node and, when it's long, its name
+REGISTER_BENCHMARK(JsonAllocations)
+{
+    constexpr std::size_t fields = 1000;
+
+    std::printf("%8s %8s %12s %12s\n", "names", "read", "overwrite", "first write");
+    for(const char* prefix : { "f", "a_field_name_too_long_for_the_small_buffer_" })
+    {
+        std::vector<std::string> names;
+        for(std::size_t i = 0; i < fields; i++)
+            names.push_back(prefix + std::to_string(i));
+
+        auto allocationsPerField = [&](auto&& access)
+        {
+            std::size_t before = Allocations::Count();
+            for(const std::string& name : names)
+                access(std::string_view(name));
+            return static_cast<double>(Allocations::Count() - before) / fields;
+        };
+
+        JsonSerializer json;
+        double firstWrite = allocationsPerField([&](std::string_view name) { json.Serialize(name, 1); });
+        double overwrite = allocationsPerField([&](std::string_view name) { json.Serialize(name, 2); });
+        double read = allocationsPerField([&](std::string_view name)
+        {
+            int value;
+            json.Deserialize(name, value);
+            Benchmark::Keep(value);
+        });
+
+        std::printf("%8s %8.2f %12.2f %12.2f\n", (prefix[1] == '\0') ? "short" : "long", read, overwrite, firstWrite);
+    }
+}
@@ -0,0 +1,89 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "../Test Project/JsonSerializer.h"
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    //Four fields, then the same again one level down until depth runs out
+    struct Chain
+    {
+        int depth;
+    };
+}
+
+template<class SerializerT>
+struct SerializeConstruct<Chain, SerializerT>
+{
+    using value_type = Chain;
+    using pointer = Chain*;
+    using reference = Chain&;
+
+    using const_pointer = const Chain*;
+    using const_reference = const Chain&;
+
+    using serializer_type = SerializerT;
+
+    static constexpr std::size_t field_count = 5;
+
+    static void Serialize(serializer_type& serializer, const_reference& v)
+    {
+        serializer.Serialize("a", v.depth);
+        serializer.Serialize("b", v.depth + 1);
+        serializer.Serialize("c", v.depth + 2);
+        serializer.Serialize("d", v.depth + 3);
+        if(v.depth > 1)
+            serializer.Serialize("child", Chain{ v.depth - 1 });
+    }
+
+    static void Deserialize(serializer_type& serializer, reference& v)
+    {
+        serializer.Deserialize("a", v.depth);
+    }
+};
+
+//Writing fields costs the same however deep the object they're in is
+REGISTER_BENCHMARK(JsonNesting)
+{
+    std::printf("%8s %16s\n", "depth", "ns per field");
+    for(int depth : { 1, 4, 16, 64, 256 })
+    {
+        std::size_t chains = 100000 / (4 * depth);
+        std::vector<std::string> names;
+        for(std::size_t i = 0; i < chains; i++)
+            names.push_back("v" + std::to_string(i));
+
+        double ns = Benchmark::NanosecondsPer(chains * 4 * depth, [&]
+        {
+            JsonSerializer json;
+            for(const std::string& name : names)
+                json.Serialize(name, Chain{ depth });
+            Benchmark::Keep(json.Data().size());
+        });
+        std::printf("%8d %16.0f\n", depth, ns);
+    }
+}
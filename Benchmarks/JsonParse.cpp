@@ -0,0 +1,75 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "../Test Project/JsonSerializer.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+//Writes a document of about megabytes MB, a flat object of small objects
+static void WriteDocument(const std::filesystem::path& path, std::size_t megabytes)
+{
+    std::ofstream stream(path, std::ios::out | std::ios::binary);
+    stream << '{';
+    std::size_t size = 1;
+    for(std::size_t i = 0; size < megabytes * 1024 * 1024; i++)
+    {
+        std::string field = ((i > 0) ? ",\"v" : "\"v") + std::to_string(i) + "\":{\"x\":" + std::to_string(i * 7919) +
+                            ",\"name\":\"record number " + std::to_string(i) + "\",\"values\":[1.5,-2,3e10]}";
+        stream << field;
+        size += field.size();
+    }
+    stream << '}';
+}
+
+//Parse only, the loader binds nothing so every field is skipped.
+//Mapping the file hands the parser its bytes without the copy reading into a string makes or the per character stream reads
+REGISTER_BENCHMARK(JsonParse)
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "JsonParseBenchmark.json";
+    JsonStreamLoader loader;
+
+    std::printf("%8s %12s %18s %12s\n", "size", "ifstream", "read into string", "mmap");
+    for(std::size_t megabytes : { 10, 100 })
+    {
+        WriteDocument(path, megabytes);
+        constexpr double msPerNs = 1e-6;
+
+        double stream = Benchmark::NanosecondsPer(1, [&] { loader.LoadFile(path); }, 3) * msPerNs;
+        double string = Benchmark::NanosecondsPer(1, [&]
+        {
+            std::ifstream file(path, std::ios::in | std::ios::binary);
+            std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            loader.Load(text);
+        }, 3) * msPerNs;
+        double mapped = Benchmark::NanosecondsPer(1, [&] { loader.LoadMapped(path); }, 3) * msPerNs;
+
+        std::printf("%5zu MB %9.0f ms %15.0f ms %9.0f ms\n", megabytes, stream, string, mapped);
+    }
+
+    std::filesystem::remove(path);
+}
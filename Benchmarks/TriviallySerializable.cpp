@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "../Test Project/BinarySerializer.h"
+#include <cstdio>
+
+namespace
+{
+    //24 bytes, no padding and no floats, so it can opt into being copied as a whole
+    struct Point
+    {
+        std::int32_t x;
+        std::int32_t y;
+        std::int64_t time;
+        std::uint16_t r;
+        std::uint16_t g;
+        std::uint16_t b;
+        std::uint16_t a;
+    };
+
+    //Same layout, written field by field
+    struct SlowPoint : Point
+    {
+    };
+}
+
+template<class SerializerT>
+struct SerializeConstruct<Point, SerializerT>
+{
+    static constexpr bool trivially_serializable = true;
+
+    static void Serialize(SerializerT& serializer, const Point& v)
+    {
+        serializer.Serialize("x", v.x);
+        serializer.Serialize("y", v.y);
+        serializer.Serialize("time", v.time);
+        serializer.Serialize("r", v.r);
+        serializer.Serialize("g", v.g);
+        serializer.Serialize("b", v.b);
+        serializer.Serialize("a", v.a);
+    }
+
+    static void Deserialize(SerializerT& serializer, Point& v)
+    {
+        serializer.Deserialize("x", v.x);
+        serializer.Deserialize("y", v.y);
+        serializer.Deserialize("time", v.time);
+        serializer.Deserialize("r", v.r);
+        serializer.Deserialize("g", v.g);
+        serializer.Deserialize("b", v.b);
+        serializer.Deserialize("a", v.a);
+    }
+};
+
+template<class SerializerT>
+struct SerializeConstruct<SlowPoint, SerializerT>
+{
+    static void Serialize(SerializerT& serializer, const SlowPoint& v)
+    {
+        SerializeConstruct<Point, SerializerT>::Serialize(serializer, v);
+    }
+
+    static void Deserialize(SerializerT& serializer, SlowPoint& v)
+    {
+        SerializeConstruct<Point, SerializerT>::Deserialize(serializer, v);
+    }
+};
+
+static_assert(sizeof(Point) == 24 && is_trivially_serializable_v<Point, BinarySerializer> && !is_trivially_serializable_v<SlowPoint, BinarySerializer>);
+
+//Writes and reads a 1M element array, in ms per pass. Fastest of several passes, so the copies mostly land in pages an earlier pass already faulted in
+template<class T>
+static void MeasureArray(const char* label)
+{
+    constexpr std::size_t count = 1000000;
+    std::vector<T> points(count);
+    for(std::size_t i = 0; i < count; i++)
+        static_cast<Point&>(points[i]) = Point{ static_cast<std::int32_t>(i), -static_cast<std::int32_t>(i), static_cast<std::int64_t>(i) * 1000, 1, 2, 3, 4 };
+
+    BinarySerializer serializer;
+    double write = Benchmark::NanosecondsPer(1, [&]
+    {
+        serializer = BinarySerializer();
+        serializer.SerializeArray("points", points.data(), points.size());
+    }) * 1e-6;
+
+    std::vector<T> read;
+    double readMs = Benchmark::NanosecondsPer(1, [&]
+    {
+        read = std::vector<T>();
+        serializer.Rewind();
+        serializer.DeserializeArray("points", read);
+        Benchmark::Keep(read.size());
+    }) * 1e-6;
+
+    std::printf("%-16s %8.1f ms %8.1f ms\n", label, write, readMs);
+}
+
+REGISTER_BENCHMARK(TriviallySerializable)
+{
+    std::printf("%-16s %11s %11s\n", "", "write", "read");
+    MeasureArray<Point>("memcpy");
+    MeasureArray<SlowPoint>("field by field");
+}
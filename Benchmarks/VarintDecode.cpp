@@ -0,0 +1,96 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include "../Test Project/BinarySerializer.h"
+#include "../Test Project/Varint.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+//Bytes per value and ns per value decoding 2^20 int32s as fixed width, as varints one at a time, and as varints with DecodeBulk
+static void MeasureDecode(const char* label, const std::vector<std::int32_t>& values)
+{
+    BinarySerializer fixed;
+    fixed.SerializeArray("values", values.data(), values.size());
+    std::vector<std::int32_t> fixedRead;
+    double fixedNs = Benchmark::NanosecondsPer(values.size(), [&]
+    {
+        fixed.Rewind();
+        fixed.DeserializeArray("values", fixedRead);
+        Benchmark::Keep(fixedRead.back());
+    });
+
+    std::vector<std::uint8_t> encoded(values.size() * Varint::maxSize<std::int32_t>);
+    std::size_t size = 0;
+    for(std::int32_t value : values)
+        size += Varint::Encode(value, encoded.data() + size);
+    encoded.resize(size);
+
+    std::vector<std::int32_t> decoded(values.size());
+    const std::uint8_t* end = encoded.data() + encoded.size();
+    double scalarNs = Benchmark::NanosecondsPer(values.size(), [&]
+    {
+        const std::uint8_t* in = encoded.data();
+        for(std::int32_t& value : decoded)
+            in += Varint::Decode(in, end, value);
+        Benchmark::Keep(decoded.back());
+    });
+    double bulkNs = Benchmark::NanosecondsPer(values.size(), [&]
+    {
+        Varint::DecodeBulk(encoded.data(), end, decoded.data(), decoded.size());
+        Benchmark::Keep(decoded.back());
+    });
+
+    std::printf("%-28s 4 B %5.1f ns %8.2f B %7.1f ns %7.1f ns\n", label, fixedNs, static_cast<double>(size) / values.size(), scalarNs, bulkNs);
+}
+
+REGISTER_BENCHMARK(VarintDecode)
+{
+    constexpr std::size_t count = std::size_t(1) << 20;
+    std::mt19937 random(42);
+    std::vector<std::int32_t> values(count);
+
+    std::printf("%-28s %13s %12s %10s %10s\n", "distribution", "fixed", "varint", "scalar", "bulk");
+
+    std::geometric_distribution<std::int32_t> counters(0.05);
+    for(std::int32_t& value : values)
+        value = counters(random);
+    MeasureDecode("counters, geometric p=.05", values);
+
+    std::normal_distribution<double> deltas(0, 40);
+    for(std::int32_t& value : values)
+        value = static_cast<std::int32_t>(std::lround(deltas(random)));
+    MeasureDecode("deltas, normal sd=40", values);
+
+    std::uniform_int_distribution<std::int32_t> ids(0, (1 << 20) - 1);
+    for(std::int32_t& value : values)
+        value = ids(random);
+    MeasureDecode("ids, uniform below 2^20", values);
+
+    std::uniform_int_distribution<std::int32_t> gaps(1, 3);
+    for(std::int32_t& value : values)
+        value = gaps(random);
+    MeasureDecode("sorted id gaps, 1..3", values);
+}
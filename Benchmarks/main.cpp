@@ -0,0 +1,59 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "Benchmark.h"
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    //Unbuffered, so each row shows up as soon as it's measured
+    std::setvbuf(stdout, nullptr, _IONBF, 0);
+
+    std::vector<Benchmark::Entry> entries = Benchmark::All();
+    for(int i = 1; i < argc; i++)
+    {
+        if(std::none_of(entries.begin(), entries.end(), [&](const Benchmark::Entry& entry) { return entry.name == argv[i]; }))
+        {
+            std::fprintf(stderr, "No benchmark called %s, there's:\n", argv[i]);
+            for(const Benchmark::Entry& entry : entries)
+                std::fprintf(stderr, "  %.*s\n", static_cast<int>(entry.name.size()), entry.name.data());
+            return 1;
+        }
+    }
+
+    for(const Benchmark::Entry& entry : entries)
+    {
+        bool named = argc == 1;
+        for(int i = 1; i < argc && !named; i++)
+            named = entry.name == argv[i];
+
+        if(!named)
+            continue;
+
+        std::printf("%.*s\n", static_cast<int>(entry.name.size()), entry.name.data());
+        entry.function();
+        std::printf("\n");
+    }
+}
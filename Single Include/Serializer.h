@@ -27,6 +27,10 @@ SOFTWARE.
 #include<string_view>
 #include<functional>
 #include<any>
+#include<string>
+#include<stdexcept>
+#include<type_traits>
+#include<vector>
 
 
 
@@ -46,11 +50,23 @@ struct SerializeConstruct;
 
     using serializer_type = SerializerT;
 
+    //Optional hints, serializers can use them to reserve space for an object up front
+    //field_count is the number of fields this Serialize writes itself, not counting base classes
+    //base_type is the base class whose SerializeConstruct this Serialize forwards to, if any
+    static constexpr std::size_t field_count = 0;
+    using base_type = Base;
+
+    //Optional opt in, for when Serialize writes every field of Type in declaration order and nothing else.
+    //Binary serializers may then copy the whole object, and arrays of them, with one memcpy.
+    //Type must be trivially copyable without padding, and shouldn't have pointers since only their address would be copied
+    static constexpr bool trivially_serializable = true;
+
     static void Serialize(serializer_type& serializer, const_reference v)
     {
         //To serialize members, just simply do the following
         //
         //  Funadmental Values / Pointers, Objects, Non-Polymorphic Object Pointers -> serializer.Serialize("x", v.x);
+        //  Usually small integers, like ids and counters                           -> SerializeVarint(serializer, "id", v.id);
         //  Polymorphic Object Pointers                                             -> serializer.PolySerialize("foo", v.foo);
         //  For base classes                                                        -> SerializeConstruct<Base, SerializerT>::Serialize(serializer, v);
     }
@@ -60,6 +76,7 @@ struct SerializeConstruct;
         //To deserialize members, just simply do the following
         //
         //  Funadmental Values / Pointers, Objects, Non-Polymorphic Object Pointers -> serializer.Deserialize("x", v.x);
+        //  Usually small integers, like ids and counters                           -> DeserializeVarint(serializer, "id", v.id);
         //  Polymorphic Object Pointers                                             -> serializer.PolyDeserialize("foo", v.foo);
         //  For base classes                                                        -> SerializeConstruct<Base, SerializerT>::Deserialize(serializer, v);
     }
@@ -90,26 +107,75 @@ public:
         //For built in value types
     }
 
-    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
-    void Serialize(std::string_view name, const T* value)
+    template<class P, std::enable_if_t<is_arithmetic_pointer_v<P>, bool> = true>
+    void Serialize(std::string_view name, const P value)
     {
         //For built in value pointer types
         //value can be a nullptr, so that case must be accounted for
 
-        //Depending on the library used for serialization
-        //c-style strings may not work, so for char*
-        //One must specialize the template, or just assume it's pointing to a single char
+        //Take the pointer by value instead of as a const T*. A const T* is just as good a match for a
+        //const C array as the array overload below, which would make serializing one ambiguous
+
+        //char pointers aren't one of them, they're C strings and go to the string overloads below
     }
 
-    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, char>, bool> = true>
     void Deserialize(std::string_view name, T*& value)
     {
         //For built in value pointer types
         //value can be a nullptr, so that case must be accounted for
 
-        //Depending on the library used for serialization
-        //c-style strings may not work, so for char*
-        //One must specialize the template, or just assume it's pointing to a single char
+        //Never char* or const char*, strings only read back into a std::string
+    }
+
+    void Serialize(std::string_view name, std::string_view value)
+    {
+        //For strings, which are values of their own rather than objects with fields or arrays of chars
+
+        //This is the one that writes, value's characters can be copied straight into the output
+    }
+
+    void Serialize(std::string_view name, const std::string& value)
+    {
+        //Needed so a std::string is a better match than the object overload below
+        //At the minimum this function must do the following
+
+        //Serialize(name, std::string_view(value));
+    }
+
+    void Serialize(std::string_view name, const char* value)
+    {
+        //For C strings, including string literals which would otherwise be arrays of chars
+        //At the minimum this function must do the following
+
+        //Serialize(name, CStringView(name, value));
+    }
+
+    void Deserialize(std::string_view name, std::string& value)
+    {
+        //For strings, std::string_view and C strings are read back into a std::string as they don't own their characters
+
+        //Assign the characters straight into value, value = std::string_view(...), so it keeps its buffer
+        //or small string storage, instead of building a temporary std::string and moving that in
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Serialize(std::string_view name, const std::vector<T>& values)
+    {
+        //For contiguous containers of built in value types, also needed for std::array<T, N> and T[N]
+        //std::vector<bool> isn't contiguous, so it isn't one of them
+
+        //Write the whole container in one go, sizing the array once up front instead of
+        //going through Serialize for every element
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Deserialize(std::string_view name, std::vector<T>& values)
+    {
+        //For contiguous containers of built in value types, also needed for std::array<T, N> and T[N]
+
+        //Resize values to the number of elements once, then fill it in place.
+        //std::array and C arrays can't be resized, so the data must have exactly N elements
     }
 
     template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
@@ -180,6 +246,43 @@ public:
         }
     }
 
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Container<T, Rest...>& values)
+    {
+        //For sequence containers of objects or concrete object pointers, std::vector, std::deque, std::list...
+        //Matching the container's template makes this a better match than the object overload above
+
+        //Write the element count, then every element the same way the object or object pointer overloads would,
+        //without a name. is_contiguous_container_v says when values.data() can be used to write them all at once
+    }
+
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Container<T, Rest...>& values)
+    {
+        //For sequence containers of objects or concrete object pointers
+
+        //Don't build each element and then copy it in, EmplaceElements sizes the container once and
+        //constructs every element in place for SerializeConstruct to fill in
+    }
+
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Map<Key, Value, Rest...>& values)
+    {
+        //For maps keyed by strings or integers, std::map, std::unordered_map, FlatMap...
+
+        //String keys can be written as an object with a field per entry, Serialize(key, value) for each.
+        //Otherwise write a sequence of key / value pairs, every value being serialized like a field of that type
+    }
+
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Map<Key, Value, Rest...>& values)
+    {
+        //For maps keyed by strings or integers
+
+        //ReserveEntries(values, count) before adding anything so unordered maps are sized once,
+        //then deserialize every value straight into EmplaceEntry(values, key)
+    }
+
     template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
     void PolySerialize(std::string_view name, const Derived* value)
     {
@@ -256,6 +359,188 @@ public:
 */
 
 
+//Number of fields SerializeConstruct<Type, SerializerT>::Serialize writes itself, 0 when unknown
+template<class Type, class SerializerT, class = void>
+struct SerializeOwnFieldCount : std::integral_constant<std::size_t, 0> {};
+
+template<class Type, class SerializerT>
+struct SerializeOwnFieldCount<Type, SerializerT, std::void_t<decltype(SerializeConstruct<Type, SerializerT>::field_count)>> :
+    std::integral_constant<std::size_t, SerializeConstruct<Type, SerializerT>::field_count> {};
+
+//Total number of fields an object of Type serializes to, following base_type through the whole chain of base classes
+template<class Type, class SerializerT, class = void>
+struct SerializeFieldCount : SerializeOwnFieldCount<Type, SerializerT> {};
+
+template<class Type, class SerializerT>
+struct SerializeFieldCount<Type, SerializerT, std::void_t<typename SerializeConstruct<Type, SerializerT>::base_type>> :
+    std::integral_constant<std::size_t, SerializeOwnFieldCount<Type, SerializerT>::value + SerializeFieldCount<typename SerializeConstruct<Type, SerializerT>::base_type, SerializerT>::value> {};
+
+template<class Type, class SerializerT>
+inline constexpr std::size_t serialize_field_count_v = SerializeFieldCount<Type, SerializerT>::value;
+
+//Whether SerializeConstruct<Type, SerializerT> opted into trivially_serializable
+template<class Type, class SerializerT, class = void>
+struct IsTriviallySerializable : std::false_type {};
+
+template<class Type, class SerializerT>
+struct IsTriviallySerializable<Type, SerializerT, std::void_t<decltype(SerializeConstruct<Type, SerializerT>::trivially_serializable)>> :
+    std::bool_constant<SerializeConstruct<Type, SerializerT>::trivially_serializable>
+{
+    static_assert(!SerializeConstruct<Type, SerializerT>::trivially_serializable || (std::is_trivially_copyable_v<Type> && std::has_unique_object_representations_v<Type>),
+        "trivially_serializable types must be trivially copyable with no padding, and no floating point members since they have more than one representation");
+};
+
+template<class Type, class SerializerT>
+inline constexpr bool is_trivially_serializable_v = IsTriviallySerializable<Type, SerializerT>::value;
+
+//Pointers to built in value types, which Serializers take by value so C arrays don't decay into them
+//char pointers are C strings rather than pointers to a single char, so they aren't one of them
+template<class T>
+inline constexpr bool is_arithmetic_pointer_v = std::is_pointer_v<T> && std::is_arithmetic_v<std::remove_pointer_t<T>> &&
+                                                !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>;
+
+//Text, which Serializers write as a value of its own rather than as an object or an array of chars
+template<class T>
+inline constexpr bool is_string_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+                                    std::is_same_v<T, const char*> || std::is_same_v<T, char*>;
+
+//The characters of a C string, for Serializers to write like any other string_view
+inline std::string_view CStringView(std::string_view name, const char* value)
+{
+    if(value == nullptr)
+        throw std::invalid_argument("Serializer: \"" + std::string(name) + "\" is a null C string");
+
+    return value;
+}
+
+template<class Container, class = void>
+struct HasReserve : std::false_type {};
+
+template<class Container>
+struct HasReserve<Container, std::void_t<decltype(std::declval<Container&>().reserve(std::size_t{}))>> : std::true_type {};
+
+//Containers of key/value pairs with unique keys, like std::map, std::unordered_map and FlatMap
+template<class Container, class = void>
+struct IsAssociativeContainer : std::false_type {};
+
+template<class Container>
+struct IsAssociativeContainer<Container, std::void_t<typename Container::key_type, typename Container::mapped_type,
+    decltype(std::declval<Container&>().try_emplace(std::declval<typename Container::key_type>()))>> : std::true_type {};
+
+template<class Container>
+inline constexpr bool is_associative_container_v = IsAssociativeContainer<Container>::value;
+
+//Containers holding their elements in order which can be appended to in place, like std::vector, std::deque and std::list.
+//Maps built on a vector, like FlatMap, aren't one
+template<class Container, class = void>
+struct IsSequenceContainer : std::false_type {};
+
+template<class Container>
+struct IsSequenceContainer<Container, std::void_t<typename Container::value_type, decltype(std::declval<const Container&>().size()),
+    decltype(std::declval<const Container&>().begin()), decltype(std::declval<Container&>().emplace_back())>> :
+    std::bool_constant<!is_associative_container_v<Container>> {};
+
+template<class Container>
+inline constexpr bool is_sequence_container_v = IsSequenceContainer<Container>::value;
+
+//Sequence containers whose elements are one block of memory, which node based ones like std::list aren't
+template<class Container, class = void>
+struct IsContiguousContainer : std::false_type {};
+
+template<class Container>
+struct IsContiguousContainer<Container, std::enable_if_t<is_sequence_container_v<Container> &&
+    std::is_same_v<decltype(std::declval<const Container&>().data()), const typename Container::value_type*>>> : std::true_type {};
+
+template<class Container>
+inline constexpr bool is_contiguous_container_v = IsContiguousContainer<Container>::value;
+
+//Sequence containers of objects or pointers to objects, which Serializers write one element after the other.
+//Strings aren't objects, so containers of them aren't one
+template<class Container, class = void>
+struct IsObjectSequence : std::false_type {};
+
+template<class Container>
+struct IsObjectSequence<Container, std::enable_if_t<is_sequence_container_v<Container>>> :
+    std::bool_constant<(std::is_class_v<typename Container::value_type> && !is_string_v<typename Container::value_type>) ||
+                       (std::is_pointer_v<typename Container::value_type> && std::is_class_v<std::remove_pointer_t<typename Container::value_type>>)> {};
+
+template<class Container>
+inline constexpr bool is_object_sequence_v = IsObjectSequence<Container>::value;
+
+//Replaces what's in container with count elements, each emplaced in place and handed to read to fill in.
+//Room is made up front for at most reserve of them, for when count comes from data that could be corrupt
+template<class Container, class Read>
+void EmplaceElements(Container& container, std::size_t count, Read&& read, std::size_t reserve)
+{
+    container.clear();
+    if constexpr(HasReserve<Container>::value)
+        container.reserve((count < reserve) ? count : reserve);
+
+    for(std::size_t i = 0; i < count; i++)
+        read(container.emplace_back());
+}
+
+template<class Container, class Read>
+void EmplaceElements(Container& container, std::size_t count, Read&& read)
+{
+    EmplaceElements(container, count, read, count);
+}
+
+//Maps keyed by strings or integers, which Serializers write as objects when the keys are strings and a key can be a field's name,
+//and as a sequence of key / value pairs otherwise
+template<class Container, class = void>
+struct IsSerializableMap : std::false_type {};
+
+template<class Container>
+struct IsSerializableMap<Container, std::enable_if_t<is_associative_container_v<Container>>> :
+    std::bool_constant<std::is_same_v<typename Container::key_type, std::string> ||
+                       (std::is_integral_v<typename Container::key_type> && !std::is_same_v<typename Container::key_type, bool>)> {};
+
+template<class Container>
+inline constexpr bool is_serializable_map_v = IsSerializableMap<Container>::value;
+
+//Makes room for count entries up front where the map can, so large unordered maps don't rehash over and over as they're read
+template<class Map>
+void ReserveEntries(Map& map, std::size_t count)
+{
+    if constexpr(HasReserve<Map>::value)
+        map.reserve(count);
+}
+
+//Returns the value of key's entry, constructing it in place if there wasn't one, for the caller to deserialize into
+template<class Map, class Key>
+typename Map::mapped_type& EmplaceEntry(Map& map, Key&& key)
+{
+    return map.try_emplace(std::forward<Key>(key)).first->second;
+}
+
+//Whether SerializerT has its own SerializeVarint / DeserializeVarint members
+template<class SerializerT, class T, class = void>
+struct HasVarintEncoding : std::false_type {};
+
+template<class SerializerT, class T>
+struct HasVarintEncoding<SerializerT, T, std::void_t<decltype(std::declval<SerializerT&>().SerializeVarint(std::string_view(), std::declval<T>()))>> : std::true_type {};
+
+//Annotation for integer fields which are usually small, like ids and counters. Use it in place of serializer.Serialize("x", v.x)
+//Serializers which have a variable length integer encoding use it for this field, every other one serializes it as usual
+template<class SerializerT, class T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+void SerializeVarint(SerializerT& serializer, std::string_view name, const T value)
+{
+    if constexpr(HasVarintEncoding<SerializerT, T>::value)
+        serializer.SerializeVarint(name, value);
+    else
+        serializer.Serialize(name, value);
+}
+
+template<class SerializerT, class T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+void DeserializeVarint(SerializerT& serializer, std::string_view name, T& value)
+{
+    if constexpr(HasVarintEncoding<SerializerT, T>::value)
+        serializer.DeserializeVarint(name, value);
+    else
+        serializer.Deserialize(name, value);
+}
+
 template<class SerializerT>
 using PolymorphicSerializerFunctionMap = std::unordered_map<std::string, std::function<void(SerializerT&, const std::any&)>>;
 
@@ -297,7 +582,7 @@ struct PolymorphicSerializeConstruct
 
     static void Serialize(serializer_type& serializer, const_pointer& v)
     {
-        serializer.Serialize("Type", std::string(typeid(*v).name()));
+        serializer.Serialize("Type", typeid(*v).name());
         GetPolymorphicSerializeFunctions<serializer_type>()[typeid(*v).name()](serializer, std::any(std::reference_wrapper<const_base_pointer>(v)));
     }
     static void Deserialize(serializer_type& serializer, pointer& v)
@@ -306,7 +591,9 @@ struct PolymorphicSerializeConstruct
         std::string type;
 
         serializer.Deserialize("Type", type);
-        GetPolymorphicDeserializeFunctions<serializer_type>()[type](serializer, any);
+
+        //at() so that concurrent deserializers only ever read the map
+        GetPolymorphicDeserializeFunctions<serializer_type>().at(type)(serializer, any);
     }
 };
 
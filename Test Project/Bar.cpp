@@ -24,5 +24,15 @@ SOFTWARE.
 */
 #include "Bar.h"
 #include "JsonSerializer.h"
+#include "BinarySerializer.h"
+#include "MsgPackSerializer.h"
+#include "CborSerializer.h"
+#include "ZeroCopySerializer.h"
+#include "ColumnarSerializer.h"
 
-REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Bar, JsonSerializer);
\ No newline at end of file
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Bar, JsonSerializer);
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Bar, BinarySerializer);
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Bar, MsgPackSerializer);
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Bar, CborSerializer);
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Bar, ZeroCopySerializer);
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Bar, ColumnarSerializer);
\ No newline at end of file
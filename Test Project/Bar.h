@@ -32,8 +32,8 @@ struct Bar : Foo
 };
 
 
-template<>
-struct SerializeConstruct<Bar, JsonSerializer>
+template<class SerializerT>
+struct SerializeConstruct<Bar, SerializerT>
 {
     using value_type = Bar;
     using pointer = Bar*;
@@ -42,19 +42,22 @@ struct SerializeConstruct<Bar, JsonSerializer>
     using const_pointer = const Bar*;
     using const_reference = const Bar&;
 
-    using serializer_type = JsonSerializer;
+    using serializer_type = SerializerT;
+
+    static constexpr std::size_t field_count = 1;
+    using base_type = Foo;
 
     static void Serialize(serializer_type& serializer, const const_reference& v)
     {
         SerializeConstruct<Foo, serializer_type>::Serialize(serializer, v);
-        serializer.Serialize("y", v.y);
+        SerializeVarint(serializer, "y", v.y);
 
     }
 
     static void Deserialize(serializer_type& serializer, reference& v)
     {
         SerializeConstruct<Foo, serializer_type>::Deserialize(serializer, v);
-        serializer.Deserialize("y", v.y);
+        DeserializeVarint(serializer, "y", v.y);
     }
 
 };
\ No newline at end of file
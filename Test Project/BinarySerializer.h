@@ -0,0 +1,1624 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include "../Single Include/Serializer.h"
+#include "Varint.h"
+#include "ByteSwap.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//Serializer concept
+//Writes every value positionally, little endian unless asked for big endian, into one growable byte buffer.
+//Objects have no framing at all, they're just their fields one after the other, so values must be
+//deserialized in the same order they were serialized.
+//Integers are either full width or varints, for the whole serializer or for fields which ask with SerializeVarint
+class BinarySerializer
+{
+public:
+    using serializer_type = BinarySerializer;
+    using buffer_type = std::vector<std::uint8_t>;
+
+    enum class Mode
+    {
+        Positional, //Field names aren't written at all
+        Named,      //Every field is preceded by its name, which is checked when it's read back
+        Schema      //Positional, but the layout of each top level value is written once per stream with its fingerprint.
+                    //Readers whose layout has the same fingerprint read positionally, any other reader matches fields up by
+                    //name, skipping ones it doesn't know and leaving ones the data doesn't have untouched
+    };
+
+    enum class IntegerEncoding
+    {
+        Fixed,  //Integers are as wide as their type
+        Varint  //Integers wider than a byte, and lengths, are LEB128 varints with zigzag for signed types
+    };
+
+    enum class ByteOrder
+    {
+        Little,
+        Big
+    };
+
+private:
+    //What a field of a schema holds, and so how its bytes are laid out
+    enum class FieldKind : std::uint8_t
+    {
+        Bool,
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float32,
+        Float64,
+        Varint,
+        UVarint,
+        String,
+        Varints,
+        UVarints,
+        Object,
+        ObjectEnd
+    };
+
+    //Set on a field's kind when a presence byte comes before its value
+    static constexpr std::uint8_t nullable = 0x80;
+
+    //Set on a number field's kind when it's a count followed by that many numbers
+    static constexpr std::uint8_t repeated = 0x40;
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    static constexpr ByteOrder hostByteOrder = ByteOrder::Big;
+#else
+    static constexpr ByteOrder hostByteOrder = ByteOrder::Little;
+#endif
+
+    //Set on a record's schema index when the schema's description comes before the record's data
+    static constexpr std::uint32_t newSchema = 0x80000000;
+
+    struct SchemaField
+    {
+        std::uint32_t nameOffset;
+        std::uint32_t nameSize;
+        std::uint8_t kind;
+    };
+
+    //The fields of one top level value in the order they were written, objects end with an ObjectEnd field
+    struct Schema
+    {
+        std::uint64_t fingerprint = 0;
+        std::string names;
+        std::vector<SchemaField> fields;
+
+        std::string_view Name(const SchemaField& field) const
+        {
+            return std::string_view(names).substr(field.nameOffset, field.nameSize);
+        }
+    };
+
+    //A field of the record being read by name. Objects hold the nodes up to end, anything else ends right after itself
+    struct Node
+    {
+        std::uint32_t field;
+        std::size_t offset;
+        std::uint32_t end;
+        bool present;
+    };
+
+    //An object being read by name, and where to start looking for its next field
+    struct NodeFrame
+    {
+        std::uint32_t node;
+        std::uint32_t cursor;
+    };
+
+    enum class SchemaState
+    {
+        Outside,    //Between top level values
+        Writing,    //Recording the schema of the value being written
+        Positional, //Reading a value whose schema matches the reader
+        Tolerant    //Reading a value by name, recording the schema the reader asks for
+    };
+
+    //Whether a reading function asking for a top level value under name laid it out the same as a schema.
+    //The name is part of the key since the same function reads under whatever name it's given, and the name is part of the layout
+    struct Compatibility
+    {
+        const std::type_info* read;
+        std::string name;
+        bool positional;
+    };
+
+    //Puts the state back between top level values however the value was left
+    struct SchemaScope
+    {
+        BinarySerializer& serializer;
+
+        ~SchemaScope()
+        {
+            serializer.schemaState = SchemaState::Outside;
+        }
+    };
+
+private:
+    buffer_type buffer;
+    std::size_t readOffset = 0;
+    Mode mode = Mode::Positional;
+    IntegerEncoding encoding = IntegerEncoding::Fixed;
+    ByteOrder byteOrder = ByteOrder::Little;
+
+    SchemaState schemaState = SchemaState::Outside;
+    Schema record;
+    std::unordered_map<std::uint64_t, std::uint32_t> writtenSchemas;
+    std::vector<Schema> readSchemas;
+
+    //Per schema read, whether each reading function's layout matched it
+    std::vector<std::vector<Compatibility>> compatibility;
+    const Schema* readSchema = nullptr;
+    std::vector<Node> nodes;
+    std::vector<NodeFrame> nodeFrames;
+    std::vector<std::uint32_t> openNodes;
+
+public:
+    BinarySerializer() = default;
+
+    explicit BinarySerializer(Mode mode, IntegerEncoding encoding = IntegerEncoding::Fixed, ByteOrder byteOrder = ByteOrder::Little) :
+        mode(mode),
+        encoding(encoding),
+        byteOrder(byteOrder)
+    {
+    }
+
+    //Creates a serializer holding a copy of bytes which were dumped by a serializer in the same mode, encoding and byte order
+    static serializer_type Parse(std::string_view bytes, Mode mode = Mode::Positional, IntegerEncoding encoding = IntegerEncoding::Fixed, ByteOrder byteOrder = ByteOrder::Little)
+    {
+        serializer_type serializer(mode, encoding, byteOrder);
+        serializer.buffer.assign(bytes.begin(), bytes.end());
+        return serializer;
+    }
+
+    static serializer_type Load(std::istream& stream, Mode mode = Mode::Positional, IntegerEncoding encoding = IntegerEncoding::Fixed, ByteOrder byteOrder = ByteOrder::Little)
+    {
+        serializer_type serializer(mode, encoding, byteOrder);
+        serializer.buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        return serializer;
+    }
+
+    static serializer_type LoadFile(const std::filesystem::path& path, Mode mode = Mode::Positional, IntegerEncoding encoding = IntegerEncoding::Fixed, ByteOrder byteOrder = ByteOrder::Little)
+    {
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        if(!stream)
+            throw std::runtime_error("BinarySerializer: could not open " + path.string());
+
+        return Load(stream, mode, encoding, byteOrder);
+    }
+
+    Mode GetMode() const
+    {
+        return mode;
+    }
+
+    IntegerEncoding GetIntegerEncoding() const
+    {
+        return encoding;
+    }
+
+    ByteOrder GetByteOrder() const
+    {
+        return byteOrder;
+    }
+
+    //Starts reading from the beginning of the data again
+    void Rewind()
+    {
+        readOffset = 0;
+    }
+
+public:
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T value)
+    {
+        if(IsRecordBoundary())
+            return WriteRecord([&] { Serialize(name, value); });
+
+        WriteField(name, KindOf<T>());
+        WriteValue(value);
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T& value)
+    {
+        if(IsRecordBoundary())
+            return ReadRecord(name, [&] { Deserialize(name, value); });
+
+        if(schemaState == SchemaState::Tolerant)
+        {
+            const Node* node = FindField(name, KindOf<T>());
+            if(node != nullptr && node->present)
+                value = ReadNode<T>(*node);
+            return;
+        }
+
+        ReadName(name);
+        value = ReadValue<T>();
+    }
+
+    template<class P, std::enable_if_t<is_arithmetic_pointer_v<P>, bool> = true>
+    void Serialize(std::string_view name, const P value)
+    {
+        if(IsRecordBoundary())
+            return WriteRecord([&] { Serialize(name, value); });
+
+        WriteField(name, KindOf<std::remove_cv_t<std::remove_pointer_t<P>>>(), true);
+        WriteValue(value != nullptr);
+
+        if(value != nullptr)
+            WriteValue(*value);
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, char>, bool> = true>
+    void Deserialize(std::string_view name, T*& value)
+    {
+        if(IsRecordBoundary())
+            return ReadRecord(name, [&] { Deserialize(name, value); });
+
+        if(schemaState == SchemaState::Tolerant)
+        {
+            if(const Node* node = FindField(name, KindOf<T>(), true))
+                value = (node->present) ? new T(ReadNode<T>(*node)) : nullptr;
+            return;
+        }
+
+        ReadName(name);
+        value = (ReadValue<bool>()) ? new T(ReadValue<T>()) : nullptr;
+    }
+
+    //Strings are values of their own rather than objects with fields
+    void Serialize(std::string_view name, std::string_view value)
+    {
+        if(IsRecordBoundary())
+            return WriteRecord([&] { Serialize(name, value); });
+
+        WriteField(name, FieldKind::String);
+        WriteString(value);
+    }
+
+    void Serialize(std::string_view name, const std::string& value)
+    {
+        Serialize(name, std::string_view(value));
+    }
+
+    void Serialize(std::string_view name, const char* value)
+    {
+        Serialize(name, CStringView(name, value));
+    }
+
+    void Deserialize(std::string_view name, std::string& value)
+    {
+        if(IsRecordBoundary())
+            return ReadRecord(name, [&] { Deserialize(name, value); });
+
+        if(schemaState == SchemaState::Tolerant)
+        {
+            const Node* node = FindField(name, FieldKind::String);
+            if(node != nullptr && node->present)
+            {
+                CheckKind(*node, FieldKind::String);
+                value = ReadAt(node->offset, [&] { return ReadString(); });
+            }
+            return;
+        }
+
+        ReadName(name);
+        value = ReadString();
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T& value)
+    {
+        if(IsRecordBoundary())
+            return WriteRecord([&] { Serialize(name, value); });
+
+        WriteField(name, FieldKind::Object);
+
+        WriteObject(value);
+
+        WriteObjectEnd();
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T& value)
+    {
+        if(IsRecordBoundary())
+            return ReadRecord(name, [&] { Deserialize(name, value); });
+
+        if(schemaState == SchemaState::Tolerant)
+        {
+            const Node* node = FindField(name, FieldKind::Object);
+            if(node != nullptr && node->present)
+            {
+                CheckKind(*node, FieldKind::Object);
+                PushNode(*node);
+                SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+                nodeFrames.pop_back();
+            }
+            RecordField({}, FieldKind::ObjectEnd);
+            return;
+        }
+
+        ReadName(name);
+
+        ReadObject(value);
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T* value)
+    {
+        if(IsRecordBoundary())
+            return WriteRecord([&] { Serialize(name, value); });
+
+        WriteField(name, FieldKind::Object, true);
+        WriteValue(value != nullptr);
+
+        if(value != nullptr)
+            WriteObject(*value);
+
+        WriteObjectEnd();
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T*& value)
+    {
+        if(IsRecordBoundary())
+            return ReadRecord(name, [&] { Deserialize(name, value); });
+
+        if(schemaState == SchemaState::Tolerant)
+        {
+            if(const Node* node = FindField(name, FieldKind::Object, true))
+            {
+                value = nullptr;
+                if(node->present)
+                {
+                    CheckKind(*node, FieldKind::Object);
+                    PushNode(*node);
+                    value = new T();
+                    SerializeConstruct<T, serializer_type>::Deserialize(*this, *value);
+                    nodeFrames.pop_back();
+                }
+            }
+            RecordField({}, FieldKind::ObjectEnd);
+            return;
+        }
+
+        ReadName(name);
+
+        if(!ReadValue<bool>())
+        {
+            value = nullptr;
+        }
+        else
+        {
+            value = new T();
+            ReadObject(*value);
+        }
+    }
+
+    //Maps are a count followed by every entry's key and value
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Map<Key, Value, Rest...>& values)
+    {
+        CheckArrayMode();
+        if(values.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("BinarySerializer: map is too large");
+
+        WriteName(name);
+        WriteValue(static_cast<std::uint32_t>(values.size()));
+        for(const auto& [key, value] : values)
+        {
+            if constexpr(std::is_same_v<Key, std::string>)
+                WriteString(key);
+            else
+                WriteValue(key);
+
+            Serialize("", value);
+        }
+    }
+
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Map<Key, Value, Rest...>& values)
+    {
+        CheckArrayMode();
+        ReadName(name);
+        std::size_t count = ReadValue<std::uint32_t>();
+
+        //Every key takes at least a byte, so a count larger than what's left is corrupt and isn't reserved for
+        values.clear();
+        ReserveEntries(values, std::min(count, buffer.size() - readOffset));
+        for(std::size_t i = 0; i < count; i++)
+        {
+            if constexpr(std::is_same_v<Key, std::string>)
+                Deserialize("", EmplaceEntry(values, std::string(ReadString())));
+            else
+                Deserialize("", EmplaceEntry(values, ReadValue<Key>()));
+        }
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolySerialize(std::string_view name, const Derived* value)
+    {
+        if(IsRecordBoundary())
+            return WriteRecord([&] { PolySerialize<Base>(name, value); });
+
+        WriteField(name, FieldKind::Object, true);
+        WriteValue(value != nullptr);
+
+        if(value != nullptr)
+            PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Serialize(*this, value);
+
+        WriteObjectEnd();
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolyDeserialize(std::string_view name, Derived*& value)
+    {
+        if(IsRecordBoundary())
+            return ReadRecord(name, [&] { PolyDeserialize<Base>(name, value); });
+
+        if(schemaState == SchemaState::Tolerant)
+        {
+            if(const Node* node = FindField(name, FieldKind::Object, true))
+            {
+                value = nullptr;
+                if(node->present)
+                {
+                    CheckKind(*node, FieldKind::Object);
+                    PushNode(*node);
+                    PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Deserialize(*this, value);
+                    nodeFrames.pop_back();
+                }
+            }
+            RecordField({}, FieldKind::ObjectEnd);
+            return;
+        }
+
+        ReadName(name);
+
+        if(!ReadValue<bool>())
+            value = nullptr;
+        else
+            PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Deserialize(*this, value);
+    }
+
+    //Per field varints, whatever the serializer's encoding is. See SerializeVarint in Serializer.h
+    template<class T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+    void SerializeVarint(std::string_view name, const T value)
+    {
+        if(IsRecordBoundary())
+            return WriteRecord([&] { SerializeVarint(name, value); });
+
+        WriteField(name, std::is_signed_v<T> ? FieldKind::Varint : FieldKind::UVarint);
+        WriteVarint(value);
+    }
+
+    template<class T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+    void DeserializeVarint(std::string_view name, T& value)
+    {
+        if(IsRecordBoundary())
+            return ReadRecord(name, [&] { DeserializeVarint(name, value); });
+
+        if(schemaState == SchemaState::Tolerant)
+        {
+            const Node* node = FindField(name, std::is_signed_v<T> ? FieldKind::Varint : FieldKind::UVarint);
+            if(node != nullptr && node->present)
+                value = ReadNode<T>(*node);
+            return;
+        }
+
+        ReadName(name);
+        value = ReadVarint<T>();
+    }
+
+    //A varint count followed by count varints, whatever the serializer's encoding is
+    template<class T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+    void SerializeVarints(std::string_view name, const T* values, std::size_t count)
+    {
+        if(IsRecordBoundary())
+            return WriteRecord([&] { SerializeVarints(name, values, count); });
+
+        WriteField(name, std::is_signed_v<T> ? FieldKind::Varints : FieldKind::UVarints);
+        WriteVarint(count);
+        WriteVarints(values, count);
+    }
+
+    template<class T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+    void DeserializeVarints(std::string_view name, std::vector<T>& values)
+    {
+        if(IsRecordBoundary())
+            return ReadRecord(name, [&] { DeserializeVarints(name, values); });
+
+        if(schemaState == SchemaState::Tolerant)
+        {
+            const Node* node = FindField(name, std::is_signed_v<T> ? FieldKind::Varints : FieldKind::UVarints);
+            if(node != nullptr && node->present)
+                ReadAt(node->offset, [&] { ReadVarintsAs(BaseKind(*node), values); return 0; });
+            return;
+        }
+
+        ReadName(name);
+        ReadVarints(values);
+    }
+
+    //A count followed by count numbers. Integers are varints if the encoding says so, anything else is one block
+    //of full width values which is copied, or byte swapped, all at once
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void SerializeArray(std::string_view name, const T* values, std::size_t count)
+    {
+        if(IsRecordBoundary())
+            return WriteRecord([&] { SerializeArray(name, values, count); });
+
+        if(count > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("BinarySerializer: array is too long");
+
+        WriteField(name, ArrayOf(KindOf<T>()));
+        WriteValue(static_cast<std::uint32_t>(count));
+        WriteArrayValues(values, count);
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void DeserializeArray(std::string_view name, std::vector<T>& values)
+    {
+        ReadArray<T>(name, [&](std::size_t count)
+        {
+            values.resize(count);
+            return values.data();
+        });
+    }
+
+    //Reads into count values which are already there, the data has to have exactly that many
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void DeserializeArray(std::string_view name, T* values, std::size_t count)
+    {
+        ReadArray<T>(name, [&](std::size_t size)
+        {
+            if(size != count)
+                throw std::runtime_error("BinarySerializer: array \"" + std::string(name) + "\" has " + std::to_string(size) + " values, expected " + std::to_string(count));
+            return values;
+        });
+    }
+
+    //Vectors, std::arrays and C arrays of numbers go through SerializeArray in one call
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Serialize(std::string_view name, const std::vector<T>& values)
+    {
+        SerializeArray(name, values.data(), values.size());
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Deserialize(std::string_view name, std::vector<T>& values)
+    {
+        DeserializeArray(name, values);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const std::array<T, N>& values)
+    {
+        SerializeArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, std::array<T, N>& values)
+    {
+        DeserializeArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T (&values)[N])
+    {
+        SerializeArray(name, values, N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T (&values)[N])
+    {
+        DeserializeArray(name, values, N);
+    }
+
+    //A count followed by count objects, trivially serializable ones are copied all at once when the mode allows it
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void SerializeArray(std::string_view name, const T* values, std::size_t count)
+    {
+        CheckArrayMode();
+        if(count > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("BinarySerializer: array is too long");
+
+        WriteName(name);
+        WriteValue(static_cast<std::uint32_t>(count));
+
+        if constexpr(is_trivially_serializable_v<T, serializer_type>)
+        {
+            if(IsRawLayout())
+                return WriteRaw(values, count);
+        }
+
+        for(std::size_t i = 0; i < count; i++)
+            SerializeConstruct<T, serializer_type>::Serialize(*this, values[i]);
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void DeserializeArray(std::string_view name, std::vector<T>& values)
+    {
+        CheckArrayMode();
+        ReadName(name);
+        std::size_t count = ReadValue<std::uint32_t>();
+
+        if constexpr(is_trivially_serializable_v<T, serializer_type>)
+        {
+            if(IsRawLayout())
+            {
+                const std::uint8_t* bytes = ReadBytes(count, sizeof(T));
+                values.resize(count);
+                std::memcpy(values.data(), bytes, count * sizeof(T));
+                return;
+            }
+        }
+
+        //The count could be corrupt, so only what's left of the data is reserved
+        EmplaceElements(values, count, [&](T& value) { SerializeConstruct<T, serializer_type>::Deserialize(*this, value); }, buffer.size() - readOffset);
+    }
+
+    //Sequences of objects or object pointers are a count followed by their elements, vectors of objects go through SerializeArray
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Container<T, Rest...>& values)
+    {
+        if constexpr(is_contiguous_container_v<Container<T, Rest...>> && std::is_class_v<T>)
+        {
+            SerializeArray(name, values.data(), values.size());
+        }
+        else
+        {
+            CheckArrayMode();
+            if(values.size() > std::numeric_limits<std::uint32_t>::max())
+                throw std::length_error("BinarySerializer: array is too long");
+
+            WriteName(name);
+            WriteValue(static_cast<std::uint32_t>(values.size()));
+            for(const T& value : values)
+                WriteElement(value);
+        }
+    }
+
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Container<T, Rest...>& values)
+    {
+        if constexpr(std::is_same_v<Container<T, Rest...>, std::vector<T>> && std::is_class_v<T>)
+        {
+            DeserializeArray(name, values);
+        }
+        else
+        {
+            CheckArrayMode();
+            ReadName(name);
+            std::size_t count = ReadValue<std::uint32_t>();
+            EmplaceElements(values, count, [&](T& value) { ReadElement(value); }, buffer.size() - readOffset);
+        }
+    }
+
+    const buffer_type& Data() const
+    {
+        return buffer;
+    }
+
+    //Appends other's data after ours, it's read back after everything we've written
+    void Merge(const serializer_type& other)
+    {
+        CheckMode(other);
+
+        if(mode == Mode::Schema)
+            MergeRecords(other);
+        else
+            buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+    }
+
+    void Merge(serializer_type&& other)
+    {
+        CheckMode(other);
+
+        if(mode == Mode::Schema)
+            MergeRecords(other);
+        else if(buffer.empty())
+            buffer = std::move(other.buffer);
+        else
+            buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+    }
+
+    std::string Dump() const
+    {
+        return std::string(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    }
+
+    void Dump(std::ostream& stream) const
+    {
+        stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    }
+
+private:
+    void CheckMode(const serializer_type& other) const
+    {
+        if(other.mode != mode || other.encoding != encoding || other.byteOrder != byteOrder)
+            throw std::invalid_argument("BinarySerializer: can't merge serializers with different modes, integer encodings or byte orders");
+    }
+
+    void WriteName(std::string_view name)
+    {
+        if(mode == Mode::Named)
+            WriteString(name);
+    }
+
+    void ReadName(std::string_view name)
+    {
+        if(mode == Mode::Named && ReadString() != name)
+            throw std::runtime_error("BinarySerializer: expected field \"" + std::string(name) + "\"");
+    }
+
+    template<class T>
+    static FieldKind KindOf()
+    {
+        FieldKind kind;
+        if constexpr(std::is_same_v<T, bool>)
+            kind = FieldKind::Bool;
+        else if constexpr(std::is_floating_point_v<T>)
+            kind = (sizeof(T) == 4) ? FieldKind::Float32 : FieldKind::Float64;
+        else if constexpr(sizeof(T) == 1)
+            kind = (std::is_signed_v<T>) ? FieldKind::Int8 : FieldKind::UInt8;
+        else if constexpr(sizeof(T) == 2)
+            kind = (std::is_signed_v<T>) ? FieldKind::Int16 : FieldKind::UInt16;
+        else if constexpr(sizeof(T) == 4)
+            kind = (std::is_signed_v<T>) ? FieldKind::Int32 : FieldKind::UInt32;
+        else
+            kind = (std::is_signed_v<T>) ? FieldKind::Int64 : FieldKind::UInt64;
+
+        return kind;
+    }
+
+    static FieldKind BaseKind(std::uint8_t kind)
+    {
+        return static_cast<FieldKind>(kind & ~nullable);
+    }
+
+    static std::uint8_t KindByte(FieldKind kind, bool isNullable)
+    {
+        return static_cast<std::uint8_t>(static_cast<std::uint8_t>(kind) | (isNullable ? nullable : 0));
+    }
+
+    static FieldKind ArrayOf(FieldKind kind)
+    {
+        return static_cast<FieldKind>(static_cast<std::uint8_t>(kind) | repeated);
+    }
+
+    FieldKind BaseKind(const Node& node) const
+    {
+        return BaseKind(readSchema->fields[node.field].kind);
+    }
+
+    //Whether objects are written exactly as they're laid out in memory, so trivially serializable ones can just be copied
+    bool IsRawLayout() const
+    {
+        return byteOrder == hostByteOrder && mode == Mode::Positional && encoding == IntegerEncoding::Fixed;
+    }
+
+    void CheckArrayMode() const
+    {
+        if(mode == Mode::Schema)
+            throw std::logic_error("BinarySerializer: arrays of objects can't be described by a schema");
+    }
+
+    template<class T>
+    void WriteObject(const T& value)
+    {
+        if constexpr(is_trivially_serializable_v<T, serializer_type>)
+        {
+            if(IsRawLayout())
+                return WriteRaw(&value, 1);
+        }
+
+        SerializeConstruct<T, serializer_type>::Serialize(*this, value);
+    }
+
+    template<class T>
+    void ReadObject(T& value)
+    {
+        if constexpr(is_trivially_serializable_v<T, serializer_type>)
+        {
+            if(IsRawLayout())
+            {
+                std::memcpy(&value, ReadBytes(sizeof(T)), sizeof(T));
+                return;
+            }
+        }
+
+        SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+    }
+
+    //An element of a sequence, which is an object or a presence byte and maybe an object
+    template<class T>
+    void WriteElement(const T& value)
+    {
+        if constexpr(std::is_pointer_v<T>)
+        {
+            WriteValue(value != nullptr);
+            if(value != nullptr)
+                WriteObject(*value);
+        }
+        else
+        {
+            WriteObject(value);
+        }
+    }
+
+    template<class T>
+    void ReadElement(T& value)
+    {
+        if constexpr(std::is_pointer_v<T>)
+        {
+            if(ReadValue<bool>())
+            {
+                value = new std::remove_pointer_t<T>();
+                ReadObject(*value);
+            }
+        }
+        else
+        {
+            ReadObject(value);
+        }
+    }
+
+    template<class T>
+    void WriteRaw(const T* values, std::size_t count)
+    {
+        const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(values);
+        buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    bool IsRecordBoundary() const
+    {
+        return mode == Mode::Schema && schemaState == SchemaState::Outside;
+    }
+
+    void RecordField(std::string_view name, FieldKind kind, bool isNullable = false)
+    {
+        if(schemaState != SchemaState::Writing && schemaState != SchemaState::Tolerant)
+            return;
+
+        std::uint8_t kindByte = KindByte(kind, isNullable);
+        record.fields.push_back(SchemaField{ static_cast<std::uint32_t>(record.names.size()), static_cast<std::uint32_t>(name.size()), kindByte });
+        record.names.append(name);
+        record.fingerprint = Fingerprint(record.fingerprint, name, kindByte);
+    }
+
+    void ResetRecord()
+    {
+        record.fingerprint = emptyFingerprint;
+        record.names.clear();
+        record.fields.clear();
+    }
+
+    void WriteField(std::string_view name, FieldKind kind, bool isNullable = false)
+    {
+        WriteName(name);
+        RecordField(name, kind, isNullable);
+    }
+
+    void WriteObjectEnd()
+    {
+        RecordField({}, FieldKind::ObjectEnd);
+    }
+
+    //FNV-1a over every field's kind and name, built up as the fields are recorded
+    static constexpr std::uint64_t emptyFingerprint = 14695981039346656037ull;
+
+    static std::uint64_t Fingerprint(std::uint64_t hash, std::string_view name, std::uint8_t kind)
+    {
+        hash = (hash ^ kind) * 1099511628211ull;
+        for(char c : name)
+            hash = (hash ^ static_cast<std::uint8_t>(c)) * 1099511628211ull;
+
+        //Ends every name with a zero byte, so names can't run into the next field
+        return hash * 1099511628211ull;
+    }
+
+    //Writes one top level value behind the index of its schema, describing the schema first if this stream hasn't seen it
+    template<class Write>
+    void WriteRecord(Write&& write)
+    {
+        std::size_t header = buffer.size();
+        WriteUnsigned<std::uint32_t>(0);
+
+        ResetRecord();
+        {
+            SchemaScope scope{ *this };
+            schemaState = SchemaState::Writing;
+            write();
+        }
+
+        std::size_t dataEnd = buffer.size();
+        auto [it, added] = writtenSchemas.try_emplace(record.fingerprint, static_cast<std::uint32_t>(writtenSchemas.size()));
+        std::uint32_t index = it->second;
+        if(added)
+        {
+            //Written after the data then rotated in front of it, a schema is only new once per stream
+            WriteDescription(record);
+            std::rotate(buffer.begin() + header + 4, buffer.begin() + dataEnd, buffer.end());
+            index |= newSchema;
+        }
+
+        StoreUnsigned(buffer.data() + header, index);
+    }
+
+    void WriteDescription(const Schema& schema)
+    {
+        WriteUnsigned(schema.fingerprint);
+        WriteUnsigned(static_cast<std::uint32_t>(schema.fields.size()));
+        for(const SchemaField& field : schema.fields)
+        {
+            std::string_view name = schema.Name(field);
+            WriteUnsigned(static_cast<std::uint32_t>(name.size()));
+            buffer.insert(buffer.end(), name.begin(), name.end());
+            WriteUnsigned(field.kind);
+        }
+    }
+
+    //Returns the index of the next record's schema, reading its description if it comes with one
+    std::uint32_t ReadRecordHeader()
+    {
+        std::uint32_t header = ReadUnsigned<std::uint32_t>();
+        std::uint32_t index = header & ~newSchema;
+
+        if(header & newSchema)
+        {
+            if(index >= readSchemas.size())
+            {
+                readSchemas.resize(index + 1);
+                compatibility.resize(index + 1);
+            }
+
+            Schema& schema = readSchemas[index];
+            schema.names.clear();
+            schema.fields.clear();
+            compatibility[index].clear();
+
+            schema.fingerprint = ReadUnsigned<std::uint64_t>();
+            std::uint32_t count = ReadUnsigned<std::uint32_t>();
+            for(std::uint32_t i = 0; i < count; i++)
+            {
+                std::uint32_t size = ReadUnsigned<std::uint32_t>();
+                const std::uint8_t* name = ReadBytes(size);
+                schema.fields.push_back(SchemaField{ static_cast<std::uint32_t>(schema.names.size()), size, ReadUnsigned<std::uint8_t>() });
+                schema.names.append(reinterpret_cast<const char*>(name), size);
+            }
+        }
+
+        if(index >= readSchemas.size() || readSchemas[index].fields.empty())
+            throw std::runtime_error("BinarySerializer: record refers to a schema the stream never described");
+
+        return index;
+    }
+
+    //Reads one top level value called name. The first time a reading function meets a schema under a name it reads by name,
+    //and from then on positionally if what it asked for had the same fingerprint
+    template<class Read>
+    void ReadRecord(std::string_view name, Read&& read)
+    {
+        std::uint32_t index = ReadRecordHeader();
+        readSchema = &readSchemas[index];
+
+        auto& known = compatibility[index];
+        auto match = std::find_if(known.begin(), known.end(), [&](const Compatibility& entry) { return entry.read == &typeid(Read) && entry.name == name; });
+
+        SchemaScope scope{ *this };
+        if(match != known.end() && match->positional)
+        {
+            schemaState = SchemaState::Positional;
+            read();
+            return;
+        }
+
+        std::size_t end = BuildNodes(*readSchema);
+        ResetRecord();
+        nodeFrames.assign(1, NodeFrame{ 0, 1 });
+
+        schemaState = SchemaState::Tolerant;
+        read();
+        readOffset = end;
+
+        if(match == known.end())
+            known.push_back(Compatibility{ &typeid(Read), std::string(name), record.fingerprint == readSchema->fingerprint });
+    }
+
+    //Lays the record's fields out as nodes so they can be found by name, and returns where its data ends
+    std::size_t BuildNodes(const Schema& schema)
+    {
+        nodes.clear();
+        nodes.push_back(Node{ 0, readOffset, 0, true });
+
+        openNodes.assign(1, 0);
+        std::size_t offset = readOffset;
+        for(std::uint32_t i = 0; i < schema.fields.size(); i++)
+        {
+            std::uint8_t kind = schema.fields[i].kind;
+            if(BaseKind(kind) == FieldKind::ObjectEnd)
+            {
+                if(openNodes.size() == 1)
+                    throw std::runtime_error("BinarySerializer: schema ends an object it never started");
+
+                nodes[openNodes.back()].end = static_cast<std::uint32_t>(nodes.size());
+                openNodes.pop_back();
+                continue;
+            }
+
+            Node node{ i, offset, static_cast<std::uint32_t>(nodes.size() + 1), true };
+            if(kind & nullable)
+            {
+                node.present = ReadAt(offset, [&] { return ReadValue<bool>(); });
+                node.offset = ++offset;
+            }
+            nodes.push_back(node);
+
+            if(BaseKind(kind) == FieldKind::Object)
+                openNodes.push_back(static_cast<std::uint32_t>(nodes.size() - 1));
+            else if(node.present)
+                offset = ReadAt(offset, [&] { SkipValue(BaseKind(kind)); return readOffset; });
+        }
+
+        if(openNodes.size() != 1)
+            throw std::runtime_error("BinarySerializer: schema leaves an object open");
+
+        nodes[0].end = static_cast<std::uint32_t>(nodes.size());
+        return offset;
+    }
+
+    void PushNode(const Node& node)
+    {
+        std::uint32_t index = static_cast<std::uint32_t>(&node - nodes.data());
+        nodeFrames.push_back(NodeFrame{ index, index + 1 });
+    }
+
+    //Records what the reader asked for and returns the field of the data with that name, if there is one
+    const Node* FindField(std::string_view name, FieldKind kind, bool isNullable = false)
+    {
+        RecordField(name, kind, isNullable);
+
+        NodeFrame& frame = nodeFrames.back();
+        const Node& parent = nodes[frame.node];
+        auto matches = [&](std::uint32_t i)
+        {
+            return readSchema->Name(readSchema->fields[nodes[i].field]) == name;
+        };
+
+        //Fields read in the order they were written are found straight away
+        for(std::uint32_t i = frame.cursor; i < parent.end; i = nodes[i].end)
+        {
+            if(matches(i))
+            {
+                frame.cursor = nodes[i].end;
+                return &nodes[i];
+            }
+        }
+        for(std::uint32_t i = frame.node + 1; i < frame.cursor; i = nodes[i].end)
+        {
+            if(matches(i))
+            {
+                frame.cursor = nodes[i].end;
+                return &nodes[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    void CheckKind(const Node& node, FieldKind kind) const
+    {
+        if(BaseKind(node) != kind)
+            throw std::runtime_error("BinarySerializer: field \"" + std::string(readSchema->Name(readSchema->fields[node.field])) + "\" changed type");
+    }
+
+    //Runs read with the read offset at offset, and puts it back after
+    template<class Read>
+    auto ReadAt(std::size_t offset, Read&& read) -> decltype(read())
+    {
+        std::size_t saved = readOffset;
+        readOffset = offset;
+
+        struct Restore
+        {
+            std::size_t& readOffset;
+            std::size_t saved;
+
+            ~Restore()
+            {
+                readOffset = saved;
+            }
+        } restore{ readOffset, saved };
+
+        return read();
+    }
+
+    //Reads a number of whatever kind the data has into a T, as long as it fits
+    template<class T>
+    T ReadNode(const Node& node)
+    {
+        return ReadAt(node.offset, [&]
+        {
+            T value{};
+            VisitNumber(BaseKind(node), [&](auto number) { value = Convert<T>(number); });
+            return value;
+        });
+    }
+
+    //Reads a number of the given kind at the read offset and hands it to visit
+    template<class Visit>
+    void VisitNumber(FieldKind kind, Visit&& visit)
+    {
+        switch(kind)
+        {
+        case FieldKind::Bool: visit(ReadValue<bool>()); break;
+        case FieldKind::Int8: visit(ReadValue<std::int8_t>()); break;
+        case FieldKind::UInt8: visit(ReadValue<std::uint8_t>()); break;
+        case FieldKind::Int16: visit(ReadValue<std::int16_t>()); break;
+        case FieldKind::UInt16: visit(ReadValue<std::uint16_t>()); break;
+        case FieldKind::Int32: visit(ReadValue<std::int32_t>()); break;
+        case FieldKind::UInt32: visit(ReadValue<std::uint32_t>()); break;
+        case FieldKind::Int64: visit(ReadValue<std::int64_t>()); break;
+        case FieldKind::UInt64: visit(ReadValue<std::uint64_t>()); break;
+        case FieldKind::Float32: visit(ReadValue<float>()); break;
+        case FieldKind::Float64: visit(ReadValue<double>()); break;
+        case FieldKind::Varint: visit(ReadVarint<std::int64_t>()); break;
+        case FieldKind::UVarint: visit(ReadVarint<std::uint64_t>()); break;
+        default:
+            throw std::runtime_error("BinarySerializer: field changed from a non number type");
+        }
+    }
+
+    void SkipValue(FieldKind kind)
+    {
+        if(static_cast<std::uint8_t>(kind) & repeated)
+        {
+            FieldKind element = static_cast<FieldKind>(static_cast<std::uint8_t>(kind) & ~repeated);
+            for(std::size_t count = ReadArrayCount(); count > 0; count--)
+                VisitNumber(element, [](auto) {});
+            return;
+        }
+
+        switch(kind)
+        {
+        case FieldKind::String:
+            ReadString();
+            break;
+        case FieldKind::Varints:
+        case FieldKind::UVarints:
+            for(std::size_t count = ReadVarint<std::size_t>(); count > 0; count--)
+                ReadVarint<std::uint64_t>();
+            break;
+        default:
+            VisitNumber(kind, [](auto) {});
+            break;
+        }
+    }
+
+    template<class T>
+    static bool IsNegative(T value)
+    {
+        if constexpr(std::is_signed_v<T>)
+            return value < 0;
+        else
+            return false;
+    }
+
+    //Converts a number read back under a different type than it was written as, throwing if it doesn't fit
+    template<class T, class V>
+    static T Convert(V value)
+    {
+        if constexpr(std::is_same_v<T, bool> || std::is_floating_point_v<T>)
+        {
+            return static_cast<T>(value);
+        }
+        else if constexpr(std::is_floating_point_v<V>)
+        {
+            if(!(value >= static_cast<V>(std::numeric_limits<T>::min()) && value < static_cast<V>(std::numeric_limits<T>::max()) + V(1)) || static_cast<V>(static_cast<T>(value)) != value)
+                throw std::out_of_range("BinarySerializer: field doesn't fit in the type it's read into");
+
+            return static_cast<T>(value);
+        }
+        else
+        {
+            T converted = static_cast<T>(value);
+            if(static_cast<V>(converted) != value || IsNegative(converted) != IsNegative(value))
+                throw std::out_of_range("BinarySerializer: field doesn't fit in the type it's read into");
+
+            return converted;
+        }
+    }
+
+    //Reads an array written by SerializeArray into what resize returns for its count
+    template<class T, class Resize>
+    void ReadArray(std::string_view name, Resize&& resize)
+    {
+        if(IsRecordBoundary())
+            return ReadRecord(name, [&] { ReadArray<T>(name, resize); });
+
+        if(schemaState == SchemaState::Tolerant)
+        {
+            const Node* node = FindField(name, ArrayOf(KindOf<T>()));
+            if(node != nullptr && node->present)
+                ReadAt(node->offset, [&] { ReadArrayAs<T>(BaseKind(*node), resize); return 0; });
+            return;
+        }
+
+        ReadName(name);
+        std::size_t count = ReadArrayCount();
+        ReadArrayValues(resize(count), count);
+    }
+
+    //Arrays of a different number type than the reader's are converted one value at a time
+    template<class T, class Resize>
+    void ReadArrayAs(FieldKind kind, Resize&& resize)
+    {
+        if(kind == ArrayOf(KindOf<T>()))
+        {
+            std::size_t count = ReadArrayCount();
+            return ReadArrayValues(resize(count), count);
+        }
+        if(!(static_cast<std::uint8_t>(kind) & repeated))
+            throw std::runtime_error("BinarySerializer: field changed from an array");
+
+        FieldKind element = static_cast<FieldKind>(static_cast<std::uint8_t>(kind) & ~repeated);
+        std::size_t count = ReadArrayCount();
+        T* values = resize(count);
+        for(std::size_t i = 0; i < count; i++)
+            VisitNumber(element, [&](auto number) { values[i] = Convert<T>(number); });
+    }
+
+    //Every value takes at least a byte, so a count larger than what's left is corrupt
+    std::size_t ReadArrayCount()
+    {
+        std::size_t count = ReadValue<std::uint32_t>();
+        if(count > buffer.size() - readOffset)
+            throw std::out_of_range("BinarySerializer: read past the end of the data");
+
+        return count;
+    }
+
+    template<class T>
+    void WriteArrayValues(const T* values, std::size_t count)
+    {
+        if constexpr(std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) > 1)
+        {
+            if(encoding == IntegerEncoding::Varint)
+                return WriteVarints(values, count);
+        }
+
+        WriteValues(values, count);
+    }
+
+    template<class T>
+    void ReadArrayValues(T* values, std::size_t count)
+    {
+        if constexpr(std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) > 1)
+        {
+            if(encoding == IntegerEncoding::Varint)
+                return ReadVarints(values, count);
+        }
+
+        ReadValues(values, count);
+    }
+
+    template<class T>
+    void ReadVarintsAs(FieldKind kind, std::vector<T>& values)
+    {
+        if(kind == (std::is_signed_v<T> ? FieldKind::Varints : FieldKind::UVarints))
+            return ReadVarints(values);
+        if(kind != FieldKind::Varints && kind != FieldKind::UVarints)
+            throw std::runtime_error("BinarySerializer: field changed from a varint array");
+
+        values.resize(ReadVarint<std::size_t>());
+        for(T& value : values)
+        {
+            if(kind == FieldKind::Varints)
+                value = Convert<T>(ReadVarint<std::int64_t>());
+            else
+                value = Convert<T>(ReadVarint<std::uint64_t>());
+        }
+    }
+
+    //Copies other's records after ours. Its schema indices are its own, so each record is looked up by fingerprint again
+    void MergeRecords(const serializer_type& other)
+    {
+        serializer_type reader(mode, encoding, byteOrder);
+        reader.buffer = other.buffer;
+
+        while(reader.readOffset < reader.buffer.size())
+        {
+            const Schema& schema = reader.readSchemas[reader.ReadRecordHeader()];
+            reader.readSchema = &schema;
+            std::size_t begin = reader.readOffset;
+            std::size_t end = reader.BuildNodes(schema);
+            reader.readOffset = end;
+
+            auto [it, added] = writtenSchemas.try_emplace(schema.fingerprint, static_cast<std::uint32_t>(writtenSchemas.size()));
+            WriteUnsigned(it->second | (added ? newSchema : 0));
+            if(added)
+                WriteDescription(schema);
+
+            buffer.insert(buffer.end(), reader.buffer.begin() + begin, reader.buffer.begin() + end);
+        }
+    }
+
+    template<class T>
+    void WriteValue(const T value)
+    {
+        static_assert(!std::is_same_v<T, long double>, "long double has no portable binary representation");
+
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            WriteUnsigned(static_cast<std::uint8_t>(value ? 1 : 0));
+        }
+        else if constexpr(std::is_floating_point_v<T>)
+        {
+            using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+            Bits bits;
+            std::memcpy(&bits, &value, sizeof(T));
+            WriteUnsigned(bits);
+        }
+        else if(sizeof(T) > 1 && encoding == IntegerEncoding::Varint)
+        {
+            WriteVarint(value);
+        }
+        else
+        {
+            WriteUnsigned(static_cast<std::make_unsigned_t<T>>(value));
+        }
+    }
+
+    template<class T>
+    T ReadValue()
+    {
+        static_assert(!std::is_same_v<T, long double>, "long double has no portable binary representation");
+
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            return ReadUnsigned<std::uint8_t>() != 0;
+        }
+        else if constexpr(std::is_floating_point_v<T>)
+        {
+            using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+            Bits bits = ReadUnsigned<Bits>();
+            T value;
+            std::memcpy(&value, &bits, sizeof(T));
+            return value;
+        }
+        else if(sizeof(T) > 1 && encoding == IntegerEncoding::Varint)
+        {
+            return ReadVarint<T>();
+        }
+        else
+        {
+            return static_cast<T>(ReadUnsigned<std::make_unsigned_t<T>>());
+        }
+    }
+
+    template<class T>
+    void WriteVarint(const T value)
+    {
+        std::uint8_t bytes[Varint::maxSize<T>];
+        buffer.insert(buffer.end(), bytes, bytes + Varint::Encode(value, bytes));
+    }
+
+    template<class T>
+    T ReadVarint()
+    {
+        T value;
+        readOffset += Varint::Decode(buffer.data() + readOffset, buffer.data() + buffer.size(), value);
+        return value;
+    }
+
+    template<class T>
+    void WriteVarints(const T* values, std::size_t count)
+    {
+        std::size_t offset = buffer.size();
+        buffer.resize(offset + count * Varint::maxSize<T>);
+        for(std::size_t i = 0; i < count; i++)
+            offset += Varint::Encode(values[i], buffer.data() + offset);
+        buffer.resize(offset);
+    }
+
+    template<class T>
+    void ReadVarints(std::vector<T>& values)
+    {
+        ReadVarints(values, ReadVarint<std::size_t>());
+    }
+
+    template<class T>
+    void ReadVarints(std::vector<T>& values, std::size_t count)
+    {
+        //Every varint is at least a byte, so a count larger than what's left is corrupt
+        if(count > buffer.size() - readOffset)
+            throw std::out_of_range("BinarySerializer: read past the end of the data");
+
+        values.resize(count);
+        ReadVarints(values.data(), count);
+    }
+
+    template<class T>
+    void ReadVarints(T* values, std::size_t count)
+    {
+        const std::uint8_t* begin = buffer.data() + readOffset;
+        readOffset += Varint::DecodeBulk(begin, buffer.data() + buffer.size(), values, count);
+    }
+
+    //Shifting out each byte is endian independent, and compilers turn it into a single store, or a store and a bswap
+    template<class U>
+    void WriteUnsigned(U value)
+    {
+        std::size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(U));
+        StoreUnsigned(buffer.data() + offset, value);
+    }
+
+    template<class U>
+    void StoreUnsigned(std::uint8_t* out, U value) const
+    {
+        if(byteOrder == ByteOrder::Little)
+        {
+            for(std::size_t i = 0; i < sizeof(U); i++)
+                out[i] = static_cast<std::uint8_t>(value >> (i * 8));
+        }
+        else
+        {
+            for(std::size_t i = 0; i < sizeof(U); i++)
+                out[i] = static_cast<std::uint8_t>(value >> ((sizeof(U) - 1 - i) * 8));
+        }
+    }
+
+    template<class U>
+    U ReadUnsigned()
+    {
+        const std::uint8_t* in = ReadBytes(sizeof(U));
+
+        U value = 0;
+        if(byteOrder == ByteOrder::Little)
+        {
+            for(std::size_t i = 0; i < sizeof(U); i++)
+                value |= static_cast<U>(static_cast<U>(in[i]) << (i * 8));
+        }
+        else
+        {
+            for(std::size_t i = 0; i < sizeof(U); i++)
+                value |= static_cast<U>(static_cast<U>(in[i]) << ((sizeof(U) - 1 - i) * 8));
+        }
+
+        return value;
+    }
+
+    //Arrays of numbers in the stream's byte order, copied as they are when it's the machine's and swapped in bulk otherwise
+    template<class T>
+    void WriteValues(const T* values, std::size_t count)
+    {
+        //An empty vector's data() may be null, which memcpy mustn't be given even for no bytes
+        if(count == 0)
+            return;
+
+        std::size_t offset = buffer.size();
+        buffer.resize(offset + count * sizeof(T));
+        std::uint8_t* out = buffer.data() + offset;
+
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            for(std::size_t i = 0; i < count; i++)
+                out[i] = values[i] ? 1 : 0;
+        }
+        else if constexpr(sizeof(T) > 1)
+        {
+            if(byteOrder != hostByteOrder)
+                return ByteSwap::Copy<sizeof(T)>(values, out, count);
+        }
+
+        if constexpr(!std::is_same_v<T, bool>)
+            std::memcpy(out, values, count * sizeof(T));
+    }
+
+    template<class T>
+    void ReadValues(T* values, std::size_t count)
+    {
+        if(count == 0)
+            return;
+
+        const std::uint8_t* in = ReadBytes(count, sizeof(T));
+
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            for(std::size_t i = 0; i < count; i++)
+                values[i] = in[i] != 0;
+        }
+        else if constexpr(sizeof(T) > 1)
+        {
+            if(byteOrder != hostByteOrder)
+                ByteSwap::Copy<sizeof(T)>(in, values, count);
+            else
+                std::memcpy(values, in, count * sizeof(T));
+        }
+        else
+        {
+            std::memcpy(values, in, count);
+        }
+    }
+
+    const std::uint8_t* ReadBytes(std::size_t size)
+    {
+        if(readOffset > buffer.size() || buffer.size() - readOffset < size)
+            throw std::out_of_range("BinarySerializer: read past the end of the data");
+
+        const std::uint8_t* bytes = buffer.data() + readOffset;
+        readOffset += size;
+        return bytes;
+    }
+
+    //count elements of size bytes each. The count comes from the data, so it's checked before multiplying
+    //since a corrupt one could wrap the product around where size_t is 32 bits
+    const std::uint8_t* ReadBytes(std::size_t count, std::size_t size)
+    {
+        if(readOffset > buffer.size() || count > (buffer.size() - readOffset) / size)
+            throw std::out_of_range("BinarySerializer: read past the end of the data");
+
+        return ReadBytes(count * size);
+    }
+
+    void WriteString(std::string_view string)
+    {
+        if(string.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("BinarySerializer: string is too long");
+
+        WriteValue(static_cast<std::uint32_t>(string.size()));
+        buffer.insert(buffer.end(), string.begin(), string.end());
+    }
+
+    std::string_view ReadString()
+    {
+        std::size_t size = ReadValue<std::uint32_t>();
+        return std::string_view(reinterpret_cast<const char*>(ReadBytes(size)), size);
+    }
+};
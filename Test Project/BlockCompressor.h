@@ -0,0 +1,469 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//LZ4 block format codec. Each sequence is a token byte holding the literal count and match length in 4 bits each
+//(15 meaning more length bytes follow, each adding up to 255), the literals, then a 2 byte little endian offset
+//back into the output and the match length past the 4 byte minimum. The last sequence is literals only
+class Lz4Block
+{
+public:
+    //Written in BlockCompressor's header so a stream can't be decoded with the wrong codec
+    static constexpr std::uint8_t id = 1;
+
+    static constexpr std::size_t MaxCompressedSize(std::size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    //Most a block of size bytes can decompress to. No byte of a sequence adds more than 255 bytes of output
+    static constexpr std::uint64_t MaxDecompressedSize(std::size_t size)
+    {
+        return std::uint64_t(size) * 255;
+    }
+
+    //Writes the compressed form of in to out, which must have room for MaxCompressedSize(size) bytes, and returns its size
+    static std::size_t Compress(const char* in, std::size_t size, char* out)
+    {
+        const auto* source = reinterpret_cast<const std::uint8_t*>(in);
+        auto* destination = reinterpret_cast<std::uint8_t*>(out);
+        std::size_t written = 0;
+        std::size_t anchor = 0;
+
+        //The format wants the last match to start 12 bytes before the end and end 5 bytes before it
+        if(size > matchStartLimit)
+        {
+            //Positions of the last 4 bytes seen with each hash. Stale or colliding entries are caught by comparing the bytes
+            std::uint32_t table[std::size_t(1) << hashBits] = {};
+            const std::size_t matchEnd = size - lastLiterals;
+            std::size_t position = 1;
+
+            while(position + matchStartLimit <= size)
+            {
+                std::uint32_t sequence = Load32(source + position);
+                std::uint32_t& slot = table[Hash(sequence)];
+                std::size_t candidate = slot;
+                slot = static_cast<std::uint32_t>(position);
+
+                if(position - candidate > maxOffset || Load32(source + candidate) != sequence)
+                {
+                    //Skips ahead faster the longer nothing has matched, so incompressible data costs little
+                    position += 1 + ((position - anchor) >> skipShift);
+                    continue;
+                }
+
+                while(position > anchor && candidate > 0 && source[position - 1] == source[candidate - 1])
+                {
+                    position--;
+                    candidate--;
+                }
+
+                std::size_t length = minMatch + MatchLength(source + position + minMatch, source + candidate + minMatch, source + matchEnd);
+                written = WriteSequence(destination, written, source + anchor, position - anchor, position - candidate, length);
+
+                position += length;
+                anchor = position;
+                if(position + matchStartLimit <= size)
+                    table[Hash(Load32(source + position - 2))] = static_cast<std::uint32_t>(position - 2);
+            }
+        }
+
+        return WriteSequence(destination, written, source + anchor, size - anchor, 0, 0);
+    }
+
+    //Decompresses in into out, which must be exactly the size the block was before compressing. Throws if the block is malformed
+    static void Decompress(const char* in, std::size_t size, char* out, std::size_t outSize)
+    {
+        const auto* source = reinterpret_cast<const std::uint8_t*>(in);
+        auto* destination = reinterpret_cast<std::uint8_t*>(out);
+        std::size_t read = 0;
+        std::size_t written = 0;
+
+        while(true)
+        {
+            if(read == size)
+                throw std::runtime_error("Lz4Block: block ends before its last literals");
+
+            std::uint8_t token = source[read++];
+            std::size_t literals = ReadLength(source, read, size, token >> 4);
+            if(literals > size - read || literals > outSize - written)
+                throw std::runtime_error("Lz4Block: literals run past the end of the block");
+
+            std::memcpy(destination + written, source + read, literals);
+            read += literals;
+            written += literals;
+            if(read == size)
+                break;
+
+            if(size - read < 2)
+                throw std::runtime_error("Lz4Block: block ends inside a match offset");
+
+            std::size_t offset = source[read] | (std::size_t(source[read + 1]) << 8);
+            read += 2;
+            if(offset == 0 || offset > written)
+                throw std::runtime_error("Lz4Block: match offset points before the start of the block");
+
+            std::size_t length = minMatch + ReadLength(source, read, size, token & 15);
+            if(length > outSize - written)
+                throw std::runtime_error("Lz4Block: match runs past the end of the output");
+
+            CopyMatch(destination + written, offset, length, outSize - written);
+            written += length;
+        }
+
+        if(written != outSize)
+            throw std::runtime_error("Lz4Block: block decompressed to the wrong size");
+    }
+
+private:
+    static constexpr std::size_t minMatch = 4;
+    static constexpr std::size_t lastLiterals = 5;
+    static constexpr std::size_t matchStartLimit = 12;
+    static constexpr std::size_t maxOffset = 65535;
+    static constexpr unsigned hashBits = 12;
+    static constexpr unsigned skipShift = 6;
+
+    static std::uint32_t Load32(const std::uint8_t* bytes)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    static std::uint64_t Load64(const std::uint8_t* bytes)
+    {
+        std::uint64_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    static std::size_t Hash(std::uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - hashBits);
+    }
+
+    static unsigned CountTrailingZeros(std::uint64_t mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+    }
+
+    //How many bytes a and b have in common, stopping at end. Compares 8 bytes at a time, the first differing byte
+    //being the lowest set one on little endian machines and the highest on big endian ones
+    static std::size_t MatchLength(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* end)
+    {
+        const std::uint8_t* start = a;
+        while(a + sizeof(std::uint64_t) <= end)
+        {
+            std::uint64_t difference = Load64(a) ^ Load64(b);
+            if(difference != 0)
+            {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                return (a - start) + static_cast<unsigned>(__builtin_clzll(difference)) / 8;
+#else
+                return (a - start) + CountTrailingZeros(difference) / 8;
+#endif
+            }
+
+            a += sizeof(std::uint64_t);
+            b += sizeof(std::uint64_t);
+        }
+
+        while(a < end && *a == *b)
+        {
+            a++;
+            b++;
+        }
+        return a - start;
+    }
+
+    static std::size_t WriteLength(std::uint8_t* out, std::size_t written, std::size_t length)
+    {
+        for(; length >= 255; length -= 255)
+            out[written++] = 255;
+        out[written++] = static_cast<std::uint8_t>(length);
+        return written;
+    }
+
+    //A match length of 0 writes the final literals only sequence
+    static std::size_t WriteSequence(std::uint8_t* out, std::size_t written, const std::uint8_t* literals, std::size_t literalCount, std::size_t offset, std::size_t matchLength)
+    {
+        std::size_t matchExtra = (matchLength > 0) ? matchLength - minMatch : 0;
+        std::size_t token = written++;
+        out[token] = static_cast<std::uint8_t>((std::min<std::size_t>(literalCount, 15) << 4) | std::min<std::size_t>(matchExtra, 15));
+
+        if(literalCount >= 15)
+            written = WriteLength(out, written, literalCount - 15);
+        std::memcpy(out + written, literals, literalCount);
+        written += literalCount;
+
+        if(matchLength > 0)
+        {
+            out[written++] = static_cast<std::uint8_t>(offset);
+            out[written++] = static_cast<std::uint8_t>(offset >> 8);
+            if(matchExtra >= 15)
+                written = WriteLength(out, written, matchExtra - 15);
+        }
+        return written;
+    }
+
+    static std::size_t ReadLength(const std::uint8_t* in, std::size_t& read, std::size_t size, std::size_t length)
+    {
+        if(length != 15)
+            return length;
+
+        std::uint8_t extra;
+        do
+        {
+            if(read == size)
+                throw std::runtime_error("Lz4Block: block ends inside a length");
+
+            extra = in[read++];
+            length += extra;
+        } while(extra == 255);
+
+        return length;
+    }
+
+    //Matches can overlap what they're copying, such as a run of one repeated byte with an offset of 1
+    static void CopyMatch(std::uint8_t* out, std::size_t offset, std::size_t length, std::size_t room)
+    {
+        const std::uint8_t* match = out - offset;
+        if(offset >= sizeof(std::uint64_t) && length + sizeof(std::uint64_t) <= room)
+        {
+            //Whole words, overshooting by up to 7 bytes which later sequences overwrite
+            for(std::size_t i = 0; i < length; i += sizeof(std::uint64_t))
+                std::memcpy(out + i, match + i, sizeof(std::uint64_t));
+        }
+        else
+        {
+            for(std::size_t i = 0; i < length; i++)
+                out[i] = match[i];
+        }
+    }
+};
+
+//Compression stage for any serializer's Dump(). The bytes are cut into blocks which are compressed independently,
+//so both directions spread the blocks over several threads. Codec needs id, MaxCompressedSize, MaxDecompressedSize,
+//Compress and Decompress like Lz4Block's.
+//The output is the codec id (u8), block size (u32) and uncompressed size (u64), then one u32 per block giving its
+//compressed size, with the high bit set when the block didn't shrink and is stored as is, then the blocks themselves
+template<class Codec = Lz4Block>
+class BlockCompressor
+{
+private:
+    std::size_t blockSize;
+    unsigned threads;
+
+    static constexpr std::size_t headerSize = 1 + 4 + 8;
+    static constexpr std::uint32_t storedFlag = 0x80000000u;
+
+public:
+    //threads of 0 uses one per core
+    explicit BlockCompressor(std::size_t blockSize = 64 * 1024, unsigned threads = 0) :
+        blockSize(blockSize),
+        threads((threads > 0) ? threads : std::max(1u, std::thread::hardware_concurrency()))
+    {
+        if(blockSize == 0 || blockSize >= storedFlag)
+            throw std::invalid_argument("BlockCompressor: block size must be between 1 byte and 2GB");
+    }
+
+    std::size_t GetBlockSize() const
+    {
+        return blockSize;
+    }
+
+    std::string Compress(std::string_view bytes) const
+    {
+        std::size_t blockCount = (bytes.size() + blockSize - 1) / blockSize;
+        std::size_t room = Codec::MaxCompressedSize(blockSize);
+        std::string scratch(blockCount * room, '\0');
+        std::vector<std::uint32_t> sizes(blockCount);
+
+        ForEachBlock(blockCount, [&](std::size_t block)
+        {
+            std::size_t offset = block * blockSize;
+            std::size_t size = std::min(blockSize, bytes.size() - offset);
+            std::size_t compressed = Codec::Compress(bytes.data() + offset, size, scratch.data() + block * room);
+            sizes[block] = (compressed < size) ? static_cast<std::uint32_t>(compressed) : static_cast<std::uint32_t>(size) | storedFlag;
+        });
+
+        std::size_t total = headerSize + blockCount * 4;
+        for(std::uint32_t size : sizes)
+            total += size & ~storedFlag;
+
+        std::string out;
+        out.reserve(total);
+        out.push_back(static_cast<char>(Codec::id));
+        AppendUnsigned(out, static_cast<std::uint32_t>(blockSize));
+        AppendUnsigned(out, static_cast<std::uint64_t>(bytes.size()));
+        for(std::uint32_t size : sizes)
+            AppendUnsigned(out, size);
+
+        for(std::size_t block = 0; block < blockCount; block++)
+        {
+            if(sizes[block] & storedFlag)
+                out.append(bytes.data() + block * blockSize, sizes[block] & ~storedFlag);
+            else
+                out.append(scratch.data() + block * room, sizes[block]);
+        }
+        return out;
+    }
+
+    //Takes anything Compress produced, whatever block size it used
+    std::string Decompress(std::string_view bytes) const
+    {
+        if(bytes.size() < headerSize)
+            throw std::runtime_error("BlockCompressor: input is shorter than the header");
+        if(static_cast<std::uint8_t>(bytes[0]) != Codec::id)
+            throw std::runtime_error("BlockCompressor: input was compressed with a different codec");
+
+        std::size_t readBlockSize = LoadUnsigned<std::uint32_t>(bytes.data() + 1);
+        std::uint64_t size = LoadUnsigned<std::uint64_t>(bytes.data() + 5);
+        if(readBlockSize == 0 && size > 0)
+            throw std::runtime_error("BlockCompressor: header has a block size of 0");
+        if(readBlockSize >= storedFlag)
+            throw std::runtime_error("BlockCompressor: header has a block size of 2GB or more");
+
+        std::uint64_t blockCount = (size > 0) ? (size - 1) / readBlockSize + 1 : 0;
+        if(blockCount > (bytes.size() - headerSize) / 4)
+            throw std::runtime_error("BlockCompressor: input is shorter than its block table");
+
+        //Each block's start comes from the sizes before it, so any thread can find any block.
+        //Every block must be able to hold its share of size before anything is allocated for it,
+        //a stored one exactly and a compressed one within what the codec can shrink it to and grow it back from
+        std::vector<std::size_t> starts(blockCount + 1);
+        starts[0] = headerSize + blockCount * 4;
+        for(std::size_t block = 0; block < blockCount; block++)
+        {
+            std::uint32_t entry = LoadUnsigned<std::uint32_t>(bytes.data() + headerSize + block * 4);
+            std::size_t compressed = entry & ~storedFlag;
+            std::uint64_t rawSize = std::min<std::uint64_t>(readBlockSize, size - block * readBlockSize);
+            if(compressed > bytes.size() - starts[block])
+                throw std::runtime_error("BlockCompressor: block runs past the end of the input");
+            if((entry & storedFlag) && compressed != rawSize)
+                throw std::runtime_error("BlockCompressor: stored block is the wrong size");
+            if(!(entry & storedFlag) && (compressed > Codec::MaxCompressedSize(static_cast<std::size_t>(rawSize)) || Codec::MaxDecompressedSize(compressed) < rawSize))
+                throw std::runtime_error("BlockCompressor: compressed block can't be the size the header says");
+            starts[block + 1] = starts[block] + compressed;
+        }
+
+        std::string out(static_cast<std::size_t>(size), '\0');
+        ForEachBlock(blockCount, [&](std::size_t block)
+        {
+            std::size_t offset = block * readBlockSize;
+            std::size_t rawSize = std::min<std::size_t>(readBlockSize, out.size() - offset);
+            std::size_t compressed = starts[block + 1] - starts[block];
+            bool stored = LoadUnsigned<std::uint32_t>(bytes.data() + headerSize + block * 4) & storedFlag;
+
+            if(stored)
+                std::memcpy(out.data() + offset, bytes.data() + starts[block], rawSize);
+            else
+                Codec::Decompress(bytes.data() + starts[block], compressed, out.data() + offset, rawSize);
+        });
+        return out;
+    }
+
+private:
+    //Runs work on every block, handing them out to the threads one at a time. The first exception thrown is rethrown here
+    template<class Function>
+    void ForEachBlock(std::size_t blockCount, Function work) const
+    {
+        std::size_t workerCount = std::min<std::size_t>(threads, blockCount);
+        if(workerCount <= 1)
+        {
+            for(std::size_t block = 0; block < blockCount; block++)
+                work(block);
+            return;
+        }
+
+        std::atomic<std::size_t> next(0);
+        std::vector<std::exception_ptr> errors(workerCount);
+        auto run = [&](std::size_t worker)
+        {
+            try
+            {
+                for(std::size_t block = next++; block < blockCount; block = next++)
+                    work(block);
+            }
+            catch(...)
+            {
+                errors[worker] = std::current_exception();
+                next = blockCount;
+            }
+        };
+
+        //The calling thread is one of the workers
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount - 1);
+        for(std::size_t worker = 1; worker < workerCount; worker++)
+            workers.emplace_back(run, worker);
+        run(0);
+        for(std::thread& worker : workers)
+            worker.join();
+
+        for(std::exception_ptr& error : errors)
+        {
+            if(error)
+                std::rethrow_exception(error);
+        }
+    }
+
+    template<class T>
+    static void AppendUnsigned(std::string& out, T value)
+    {
+        for(std::size_t i = 0; i < sizeof(T); i++)
+            out.push_back(static_cast<char>(value >> (i * 8)));
+    }
+
+    template<class T>
+    static T LoadUnsigned(const char* bytes)
+    {
+        T value = 0;
+        for(std::size_t i = 0; i < sizeof(T); i++)
+            value |= static_cast<T>(static_cast<std::uint8_t>(bytes[i])) << (i * 8);
+        return value;
+    }
+};
@@ -0,0 +1,245 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BYTESWAP_X86
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <stdlib.h>
+#endif
+
+//GCC and Clang only let a function use SSSE3 and AVX2 intrinsics when it's compiled for them,
+//which is done per function so the rest of the program still runs on CPUs without them
+#if defined(BYTESWAP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define BYTESWAP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define BYTESWAP_TARGET(isa)
+#endif
+
+//Reverses the bytes of 2, 4 and 8 byte values, for data written in the other byte order.
+//Whole arrays go through the widest kernel the CPU has, which is picked the first time one is swapped:
+//pshufb on 32 bytes at a time with AVX2, 16 with SSSE3, otherwise one value at a time
+class ByteSwap
+{
+public:
+    enum class Kernel
+    {
+        Scalar,
+        Ssse3,
+        Avx2
+    };
+
+private:
+    using CopyFunction = void(*)(const std::uint8_t* in, std::uint8_t* out, std::size_t count);
+
+    struct Table
+    {
+        Kernel kernel;
+        CopyFunction copy[3];
+    };
+
+    //pshufb masks reversing every 2, 4 and 8 bytes, twice so AVX2 can load 32 of them
+    alignas(32) static constexpr std::uint8_t masks[3][32] =
+    {
+        { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+        { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+        { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 }
+    };
+
+public:
+    static std::uint16_t Swap(std::uint16_t value)
+    {
+#ifdef _MSC_VER
+        return _byteswap_ushort(value);
+#else
+        return __builtin_bswap16(value);
+#endif
+    }
+
+    static std::uint32_t Swap(std::uint32_t value)
+    {
+#ifdef _MSC_VER
+        return _byteswap_ulong(value);
+#else
+        return __builtin_bswap32(value);
+#endif
+    }
+
+    static std::uint64_t Swap(std::uint64_t value)
+    {
+#ifdef _MSC_VER
+        return _byteswap_uint64(value);
+#else
+        return __builtin_bswap64(value);
+#endif
+    }
+
+    //Copies count values of Width bytes from in to out with each one's bytes reversed. in and out can be the same
+    template<std::size_t Width>
+    static void Copy(const void* in, void* out, std::size_t count)
+    {
+        static_assert(Width == 2 || Width == 4 || Width == 8, "ByteSwap: only 2, 4 and 8 byte values can be swapped");
+        Selected().copy[IndexOf(Width)](static_cast<const std::uint8_t*>(in), static_cast<std::uint8_t*>(out), count);
+    }
+
+    static Kernel SelectedKernel()
+    {
+        return Selected().kernel;
+    }
+
+    //Whether this CPU can run kernel
+    static bool Supports(Kernel kernel)
+    {
+        static const Kernel best = Detect();
+        return kernel <= best;
+    }
+
+    //Makes Copy use kernel from now on, for testing and benchmarking the ones this machine wouldn't pick.
+    //Returns false and changes nothing if the CPU can't run it. Not safe while other threads are swapping
+    static bool Select(Kernel kernel)
+    {
+        if(!Supports(kernel))
+            return false;
+
+        Selected() = TableOf(kernel);
+        return true;
+    }
+
+private:
+    static constexpr std::size_t IndexOf(std::size_t width)
+    {
+        return (width == 2) ? 0 : (width == 4) ? 1 : 2;
+    }
+
+    static Table& Selected()
+    {
+        static Table table = TableOf(Detect());
+        return table;
+    }
+
+    static Table TableOf(Kernel kernel)
+    {
+        switch(kernel)
+        {
+#ifdef BYTESWAP_X86
+        case Kernel::Avx2:
+            return Table{ kernel, { CopyAvx2<2>, CopyAvx2<4>, CopyAvx2<8> } };
+        case Kernel::Ssse3:
+            return Table{ kernel, { CopySsse3<2>, CopySsse3<4>, CopySsse3<8> } };
+#endif
+        default:
+            return Table{ Kernel::Scalar, { CopyScalar<2>, CopyScalar<4>, CopyScalar<8> } };
+        }
+    }
+
+    static Kernel Detect()
+    {
+#if defined(BYTESWAP_X86) && !defined(_MSC_VER)
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+            return Kernel::Avx2;
+        if(__builtin_cpu_supports("ssse3"))
+            return Kernel::Ssse3;
+#elif defined(BYTESWAP_X86)
+        int info[4];
+        __cpuid(info, 0);
+        int highest = info[0];
+
+        __cpuid(info, 1);
+        bool ssse3 = (info[2] & (1 << 9)) != 0;
+
+        //AVX2 also needs the OS to save the upper halves of the registers
+        bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+        if(highest >= 7 && osSavesAvx)
+        {
+            __cpuidex(info, 7, 0);
+            if(info[1] & (1 << 5))
+                return Kernel::Avx2;
+        }
+        if(ssse3)
+            return Kernel::Ssse3;
+#endif
+        return Kernel::Scalar;
+    }
+
+    template<std::size_t Width>
+    static void CopyScalar(const std::uint8_t* in, std::uint8_t* out, std::size_t count)
+    {
+        using U = std::conditional_t<Width == 2, std::uint16_t, std::conditional_t<Width == 4, std::uint32_t, std::uint64_t>>;
+
+        for(std::size_t i = 0; i < count; i++)
+        {
+            U value;
+            std::memcpy(&value, in + i * Width, Width);
+            value = Swap(value);
+            std::memcpy(out + i * Width, &value, Width);
+        }
+    }
+
+#ifdef BYTESWAP_X86
+    template<std::size_t Width>
+    BYTESWAP_TARGET("ssse3")
+    static void CopySsse3(const std::uint8_t* in, std::uint8_t* out, std::size_t count)
+    {
+        const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(masks[IndexOf(Width)]));
+
+        std::size_t size = count * Width;
+        std::size_t i = 0;
+        for(; i + 16 <= size; i += 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(bytes, mask));
+        }
+
+        CopyScalar<Width>(in + i, out + i, (size - i) / Width);
+    }
+
+    template<std::size_t Width>
+    BYTESWAP_TARGET("avx2")
+    static void CopyAvx2(const std::uint8_t* in, std::uint8_t* out, std::size_t count)
+    {
+        const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(masks[IndexOf(Width)]));
+
+        std::size_t size = count * Width;
+        std::size_t i = 0;
+        for(; i + 32 <= size; i += 32)
+        {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(bytes, mask));
+        }
+
+        //Less than 32 bytes left, at most one more 16 byte step
+        CopySsse3<Width>(in + i, out + i, (size - i) / Width);
+    }
+#endif
+};
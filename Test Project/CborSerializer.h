@@ -0,0 +1,1065 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include "../Single Include/Serializer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+//Serializer concept
+//Encodes RFC 8949 CBOR straight into a byte buffer as values are serialized, and decodes straight out of it,
+//without ever building a DOM. Objects are maps keyed by field name, the whole serializer is one root map.
+//Numbers use the preferred serialization, the shortest head or float width that holds the value exactly,
+//and std::vector<std::byte> is written as a byte string
+class CborSerializer
+{
+public:
+    using serializer_type = CborSerializer;
+    using buffer_type = std::vector<std::uint8_t>;
+    using bytes_type = std::vector<std::byte>;
+
+private:
+    enum Major : std::uint8_t
+    {
+        Unsigned = 0,
+        Negative = 1,
+        Bytes = 2,
+        Text = 3,
+        Array = 4,
+        Map = 5,
+        Tag = 6,
+        Simple = 7
+    };
+
+    static constexpr std::uint8_t indefinite = 31;
+    static constexpr std::uint8_t breakByte = 0xff;
+    static constexpr std::uint8_t falseByte = 0xf4;
+    static constexpr std::uint8_t trueByte = 0xf5;
+    static constexpr std::uint8_t nullByte = 0xf6;
+    static constexpr std::uint8_t halfByte = 0xf9;
+    static constexpr std::uint8_t floatByte = 0xfa;
+    static constexpr std::uint8_t doubleByte = 0xfb;
+
+    //A map being written. Its head is patched in once we know how many fields it has
+    struct WriteFrame
+    {
+        std::size_t headOffset;
+        std::size_t headSize;
+        std::uint32_t count;
+    };
+
+    //A map being read. Fields are searched for starting after the last one found, so reading them
+    //in the order they were written never has to look at the same entry twice
+    struct ReadFrame
+    {
+        std::size_t begin;
+        std::uint32_t count;
+        std::size_t next;
+        std::uint32_t nextIndex;
+    };
+
+    //The root map's head always has a 4 byte count while we hold it, so it can be patched in place
+    static constexpr std::size_t rootHeadSize = 5;
+
+    buffer_type buffer{ (Map << 5) | 26, 0, 0, 0, 0 };
+    std::vector<WriteFrame> writeFrames{ WriteFrame{ 0, rootHeadSize, 0 } };
+    ReadFrame rootRead{ rootHeadSize, 0, rootHeadSize, 0 };
+    std::vector<ReadFrame> readFrames;
+
+public:
+    CborSerializer() = default;
+
+    //Creates a serializer holding a copy of a CBOR data item which is a map
+    static serializer_type Parse(std::string_view bytes)
+    {
+        serializer_type serializer;
+        serializer.buffer.assign(bytes.begin(), bytes.end());
+
+        std::size_t begin = 0;
+        std::uint32_t count = serializer.ReadMapHead(begin);
+        std::size_t end = begin;
+        for(std::uint64_t i = 0; i < count * std::uint64_t(2); i++)
+            end = serializer.SkipItem(end);
+
+        //Drops the original head, and the break of an indefinite length map
+        serializer.buffer.erase(serializer.buffer.begin() + end, serializer.buffer.end());
+        serializer.buffer.erase(serializer.buffer.begin(), serializer.buffer.begin() + begin);
+        serializer.buffer.insert(serializer.buffer.begin(), rootHeadSize, 0);
+        serializer.writeFrames[0].count = count;
+        serializer.WriteMapHead(0, count, rootHeadSize);
+
+        return serializer;
+    }
+
+    static serializer_type Load(std::istream& stream)
+    {
+        std::string bytes(std::istreambuf_iterator<char>(stream), {});
+        return Parse(bytes);
+    }
+
+    static serializer_type LoadFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        if(!stream)
+            throw std::runtime_error("CborSerializer: could not open " + path.string());
+
+        return Load(stream);
+    }
+
+public:
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T value)
+    {
+        WriteKey(name);
+        WriteNumber(value);
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T& value)
+    {
+        value = ReadNumber<T>(FindField(name));
+    }
+
+    template<class P, std::enable_if_t<is_arithmetic_pointer_v<P>, bool> = true>
+    void Serialize(std::string_view name, const P value)
+    {
+        WriteKey(name);
+
+        if(value == nullptr)
+            buffer.push_back(nullByte);
+        else
+            WriteNumber(*value);
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, char>, bool> = true>
+    void Deserialize(std::string_view name, T*& value)
+    {
+        std::size_t offset = FindField(name);
+        value = (IsNull(offset)) ? nullptr : new T(ReadNumber<T>(offset));
+    }
+
+    //Contiguous arrays of numbers are CBOR arrays, written and read in one pass
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Serialize(std::string_view name, const std::vector<T>& values)
+    {
+        SerializeArray(name, values.data(), values.size());
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Deserialize(std::string_view name, std::vector<T>& values)
+    {
+        std::size_t offset = FindField(name);
+        values.resize(ReadArrayHead(offset));
+        ReadNumbers(offset, values.data(), values.size());
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const std::array<T, N>& values)
+    {
+        SerializeArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, std::array<T, N>& values)
+    {
+        DeserializeArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T (&values)[N])
+    {
+        SerializeArray(name, values, N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T (&values)[N])
+    {
+        DeserializeArray(name, values, N);
+    }
+
+    //Strings are values of their own rather than objects with fields
+    void Serialize(std::string_view name, std::string_view value)
+    {
+        WriteKey(name);
+        WriteHead(Text, value.size());
+        buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+
+    void Serialize(std::string_view name, const std::string& value)
+    {
+        Serialize(name, std::string_view(value));
+    }
+
+    void Serialize(std::string_view name, const char* value)
+    {
+        Serialize(name, CStringView(name, value));
+    }
+
+    void Deserialize(std::string_view name, std::string& value)
+    {
+        value.clear();
+        ReadChunks(FindField(name), Text, value);
+    }
+
+    //Blobs are byte strings, so they cost their size plus a head instead of growing by a third as base64
+    void Serialize(std::string_view name, const bytes_type& value)
+    {
+        WriteKey(name);
+        WriteHead(Bytes, value.size());
+
+        std::size_t offset = buffer.size();
+        buffer.resize(offset + value.size());
+        if(!value.empty())
+            std::memcpy(buffer.data() + offset, value.data(), value.size());
+    }
+
+    void Deserialize(std::string_view name, bytes_type& value)
+    {
+        value.clear();
+        ReadChunks(FindField(name), Bytes, value);
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T& value)
+    {
+        WriteKey(name);
+        OpenMap(serialize_field_count_v<T, serializer_type>);
+
+        SerializeConstruct<T, serializer_type>::Serialize(*this, value);
+
+        CloseMap();
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T& value)
+    {
+        PushReadFrame(FindField(name));
+
+        SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+
+        readFrames.pop_back();
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T* value)
+    {
+        if(value == nullptr)
+        {
+            WriteKey(name);
+            buffer.push_back(nullByte);
+        }
+        else
+        {
+            Serialize(name, *value);
+        }
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T*& value)
+    {
+        std::size_t offset = FindField(name);
+
+        if(IsNull(offset))
+        {
+            value = nullptr;
+        }
+        else
+        {
+            PushReadFrame(offset);
+
+            value = new T();
+            SerializeConstruct<T, serializer_type>::Deserialize(*this, *value);
+
+            readFrames.pop_back();
+        }
+    }
+
+    //Sequences of objects or object pointers are CBOR arrays of maps, null for the null pointers
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Container<T, Rest...>& values)
+    {
+        WriteKey(name);
+        WriteHead(Array, values.size());
+
+        for(const T& value : values)
+        {
+            if constexpr(std::is_pointer_v<T>)
+            {
+                if(value == nullptr)
+                    buffer.push_back(nullByte);
+                else
+                    WriteElement(*value);
+            }
+            else
+            {
+                WriteElement(value);
+            }
+        }
+    }
+
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Container<T, Rest...>& values)
+    {
+        std::size_t offset = FindField(name);
+        std::size_t count = ReadArrayHead(offset);
+        EmplaceElements(values, count, [&](T& value)
+        {
+            if constexpr(std::is_pointer_v<T>)
+            {
+                if(!IsNull(offset))
+                {
+                    value = new std::remove_pointer_t<T>();
+                    ReadElement(offset, *value);
+                }
+            }
+            else
+            {
+                ReadElement(offset, value);
+            }
+            offset = SkipItem(offset);
+        });
+    }
+
+    //Maps keyed by strings are CBOR maps with a field per entry, any other map is an array of { "key", "value" } maps
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Map<Key, Value, Rest...>& values)
+    {
+        WriteKey(name);
+        if constexpr(std::is_same_v<Key, std::string>)
+        {
+            OpenMap(values.size());
+            for(const auto& [key, value] : values)
+                Serialize(key, value);
+            CloseMap();
+        }
+        else
+        {
+            WriteHead(Array, values.size());
+            for(const auto& [key, value] : values)
+            {
+                OpenMap(2);
+                Serialize("key", key);
+                Serialize("value", value);
+                CloseMap();
+            }
+        }
+    }
+
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Map<Key, Value, Rest...>& values)
+    {
+        std::size_t offset = FindField(name);
+        values.clear();
+
+        if constexpr(std::is_same_v<Key, std::string>)
+        {
+            PushReadFrame(offset);
+            ReadFrame frame = readFrames.back();
+
+            //Every entry takes at least two bytes, so a count larger than that is corrupt and isn't reserved for
+            ReserveEntries(values, std::min<std::size_t>(frame.count, (buffer.size() - frame.begin) / 2));
+
+            //Entries are read in order, so every field is found straight away where the last one ended
+            std::size_t entry = frame.begin;
+            for(std::uint32_t i = 0; i < frame.count; i++)
+            {
+                std::string_view key = ReadText(entry);
+                entry = SkipItem(entry);
+                Deserialize(key, EmplaceEntry(values, std::string(key)));
+            }
+            readFrames.pop_back();
+        }
+        else
+        {
+            std::size_t count = ReadArrayHead(offset);
+            ReserveEntries(values, count);
+            for(std::size_t i = 0; i < count; i++)
+            {
+                PushReadFrame(offset);
+                Key key{};
+                Deserialize("key", key);
+                Deserialize("value", EmplaceEntry(values, key));
+                readFrames.pop_back();
+                offset = SkipItem(offset);
+            }
+        }
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolySerialize(std::string_view name, const Derived* value)
+    {
+        WriteKey(name);
+
+        if(value == nullptr)
+        {
+            buffer.push_back(nullByte);
+        }
+        else
+        {
+            OpenMap(0);
+
+            PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Serialize(*this, value);
+
+            CloseMap();
+        }
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolyDeserialize(std::string_view name, Derived*& value)
+    {
+        std::size_t offset = FindField(name);
+
+        if(IsNull(offset))
+        {
+            value = nullptr;
+        }
+        else
+        {
+            PushReadFrame(offset);
+
+            PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Deserialize(*this, value);
+
+            readFrames.pop_back();
+        }
+    }
+
+    //The encoded data item, with a 4 byte count in the root map's head
+    const buffer_type& Data() const
+    {
+        return buffer;
+    }
+
+    //Adds every top level field of other we don't already have
+    void Merge(const serializer_type& other)
+    {
+        std::unordered_set<std::string_view> names;
+        for(std::size_t offset = rootHeadSize; offset < buffer.size();)
+        {
+            names.insert(ReadText(offset));
+            offset = SkipItem(offset);
+        }
+
+        //Other's buffer could be ourselves, copy out what we need before we start appending
+        buffer_type entries;
+        std::uint32_t count = 0;
+        for(std::size_t offset = rootHeadSize; offset < other.buffer.size();)
+        {
+            std::size_t value = offset;
+            std::string_view key = other.ReadText(value);
+            std::size_t end = other.SkipItem(value);
+            if(names.count(key) == 0)
+            {
+                entries.insert(entries.end(), other.buffer.begin() + offset, other.buffer.begin() + end);
+                count++;
+            }
+            offset = end;
+        }
+
+        buffer.insert(buffer.end(), entries.begin(), entries.end());
+        writeFrames[0].count += count;
+        WriteMapHead(0, writeFrames[0].count, rootHeadSize);
+    }
+
+    //Returns the data item with the shortest head that fits the root map
+    std::string Dump() const
+    {
+        std::uint32_t count = writeFrames[0].count;
+        std::size_t headSize = HeadSize(count);
+
+        std::string bytes(headSize + buffer.size() - rootHeadSize, '\0');
+        std::uint8_t head[rootHeadSize];
+        EncodeHead(head, Map, count, headSize);
+        std::memcpy(bytes.data(), head, headSize);
+        std::memcpy(bytes.data() + headSize, buffer.data() + rootHeadSize, buffer.size() - rootHeadSize);
+
+        return bytes;
+    }
+
+private:
+    template<class T>
+    void SerializeArray(std::string_view name, const T* values, std::size_t count)
+    {
+        WriteKey(name);
+        WriteHead(Array, count);
+
+        //Every number takes at most 9 bytes, most of them far fewer
+        buffer.reserve(buffer.size() + count * (1 + sizeof(T)));
+        for(std::size_t i = 0; i < count; i++)
+            WriteNumber(values[i]);
+    }
+
+    //Arrays that can't be resized must find exactly as many values in the data
+    template<class T>
+    void DeserializeArray(std::string_view name, T* values, std::size_t count)
+    {
+        std::size_t offset = FindField(name);
+        std::size_t size = ReadArrayHead(offset);
+        if(size != count)
+            throw std::runtime_error("CborSerializer: array \"" + std::string(name) + "\" has " + std::to_string(size) + " values, expected " + std::to_string(count));
+
+        ReadNumbers(offset, values, count);
+    }
+
+    template<class T>
+    void ReadNumbers(std::size_t offset, T* values, std::size_t count) const
+    {
+        for(std::size_t i = 0; i < count; i++)
+        {
+            values[i] = ReadNumber<T>(offset);
+            offset = SkipItem(offset);
+        }
+    }
+
+    template<class T>
+    void WriteElement(const T& value)
+    {
+        OpenMap(serialize_field_count_v<T, serializer_type>);
+        SerializeConstruct<T, serializer_type>::Serialize(*this, value);
+        CloseMap();
+    }
+
+    template<class T>
+    void ReadElement(std::size_t offset, T& value)
+    {
+        PushReadFrame(offset);
+        SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+        readFrames.pop_back();
+    }
+
+    void WriteKey(std::string_view name)
+    {
+        WriteFrame& frame = writeFrames.back();
+        frame.count++;
+
+        if(writeFrames.size() == 1)
+            WriteMapHead(0, frame.count, rootHeadSize);
+
+        WriteHead(Text, name.size());
+        buffer.insert(buffer.end(), name.begin(), name.end());
+    }
+
+    //fieldCount is only a guess for the head's size, 0 when unknown
+    void OpenMap(std::size_t fieldCount)
+    {
+        std::size_t headSize = (fieldCount > 0) ? HeadSize(fieldCount) : 5;
+        writeFrames.push_back(WriteFrame{ buffer.size(), headSize, 0 });
+        buffer.resize(buffer.size() + headSize);
+    }
+
+    //Writes the map's head now that we know its size, shifting its fields if the guess was wrong
+    void CloseMap()
+    {
+        WriteFrame frame = writeFrames.back();
+        writeFrames.pop_back();
+
+        std::size_t headSize = HeadSize(frame.count);
+        auto head = buffer.begin() + frame.headOffset;
+        if(headSize > frame.headSize)
+            buffer.insert(head, headSize - frame.headSize, 0);
+        else if(headSize < frame.headSize)
+            buffer.erase(head, head + (frame.headSize - headSize));
+
+        WriteMapHead(frame.headOffset, frame.count, headSize);
+    }
+
+    static std::size_t HeadSize(std::uint64_t argument)
+    {
+        return (argument < 24) ? 1 : (argument <= 0xff) ? 2 : (argument <= 0xffff) ? 3 : (argument <= 0xffffffff) ? 5 : 9;
+    }
+
+    static void EncodeHead(std::uint8_t* out, Major major, std::uint64_t argument, std::size_t headSize)
+    {
+        std::uint8_t type = static_cast<std::uint8_t>(major << 5);
+        switch(headSize)
+        {
+        case 1:
+            out[0] = static_cast<std::uint8_t>(type | argument);
+            break;
+        case 2:
+            out[0] = type | 24;
+            out[1] = static_cast<std::uint8_t>(argument);
+            break;
+        case 3:
+            out[0] = type | 25;
+            EncodeBigEndian(out + 1, static_cast<std::uint16_t>(argument));
+            break;
+        case 5:
+            out[0] = type | 26;
+            EncodeBigEndian(out + 1, static_cast<std::uint32_t>(argument));
+            break;
+        default:
+            out[0] = type | 27;
+            EncodeBigEndian(out + 1, argument);
+            break;
+        }
+    }
+
+    void WriteHead(Major major, std::uint64_t argument)
+    {
+        std::size_t offset = buffer.size();
+        std::size_t headSize = HeadSize(argument);
+        buffer.resize(offset + headSize);
+        EncodeHead(buffer.data() + offset, major, argument, headSize);
+    }
+
+    void WriteMapHead(std::size_t offset, std::uint32_t count, std::size_t headSize)
+    {
+        EncodeHead(buffer.data() + offset, Map, count, headSize);
+    }
+
+    template<class U>
+    static void EncodeBigEndian(std::uint8_t* out, U value)
+    {
+        for(std::size_t i = 0; i < sizeof(U); i++)
+            out[i] = static_cast<std::uint8_t>(value >> ((sizeof(U) - 1 - i) * 8));
+    }
+
+    template<class U>
+    void WriteBigEndian(std::uint8_t type, U value)
+    {
+        std::size_t offset = buffer.size();
+        buffer.resize(offset + 1 + sizeof(U));
+        buffer[offset] = type;
+        EncodeBigEndian(buffer.data() + offset + 1, value);
+    }
+
+    template<class T>
+    void WriteNumber(const T value)
+    {
+        static_assert(!std::is_same_v<T, long double>, "long double has no CBOR representation");
+
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            buffer.push_back(value ? trueByte : falseByte);
+        }
+        else if constexpr(std::is_floating_point_v<T>)
+        {
+            std::uint16_t half;
+            if(ToHalf(value, half))
+            {
+                WriteBigEndian(halfByte, half);
+            }
+            else if(sizeof(T) == 4 || static_cast<double>(static_cast<float>(value)) == value)
+            {
+                float f = static_cast<float>(value);
+                std::uint32_t bits;
+                std::memcpy(&bits, &f, sizeof(bits));
+                WriteBigEndian(floatByte, bits);
+            }
+            else
+            {
+                double d = value;
+                std::uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(bits));
+                WriteBigEndian(doubleByte, bits);
+            }
+        }
+        else if constexpr(std::is_signed_v<T>)
+        {
+            //Negative integers are stored as -1 - n, which always fits in the unsigned argument
+            std::int64_t v = value;
+            if(v >= 0)
+                WriteHead(Unsigned, static_cast<std::uint64_t>(v));
+            else
+                WriteHead(Negative, static_cast<std::uint64_t>(-1 - v));
+        }
+        else
+        {
+            WriteHead(Unsigned, static_cast<std::uint64_t>(value));
+        }
+    }
+
+    //Returns true if value is exactly representable as a half precision float, NaNs collapse to the canonical quiet NaN
+    static bool ToHalf(double value, std::uint16_t& half)
+    {
+        if(std::isnan(value))
+        {
+            half = 0x7e00;
+            return true;
+        }
+        if(static_cast<double>(static_cast<float>(value)) != value)
+            return false;
+
+        float f = static_cast<float>(value);
+        std::uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+
+        std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000);
+        std::int32_t exponent = static_cast<std::int32_t>((bits >> 23) & 0xff);
+        std::uint32_t mantissa = bits & 0x7fffff;
+
+        if(exponent == 0 && mantissa == 0)
+        {
+            half = sign;
+            return true;
+        }
+        if(exponent == 0xff)
+        {
+            half = sign | 0x7c00;
+            return true;
+        }
+
+        exponent -= 127;
+        if(exponent >= -14 && exponent <= 15)
+        {
+            if((mantissa & 0x1fff) != 0)
+                return false;
+
+            half = static_cast<std::uint16_t>(sign | ((exponent + 15) << 10) | (mantissa >> 13));
+            return true;
+        }
+        if(exponent >= -24 && exponent < -14)
+        {
+            //Subnormal halves, the implicit leading bit becomes part of the mantissa
+            std::uint32_t full = mantissa | 0x800000;
+            std::uint32_t shift = static_cast<std::uint32_t>(13 + (-14 - exponent));
+            if((full & ((1u << shift) - 1)) != 0)
+                return false;
+
+            half = static_cast<std::uint16_t>(sign | (full >> shift));
+            return true;
+        }
+
+        return false;
+    }
+
+    static double FromHalf(std::uint16_t half)
+    {
+        int exponent = (half >> 10) & 0x1f;
+        int mantissa = half & 0x3ff;
+
+        double value;
+        if(exponent == 0)
+            value = std::ldexp(mantissa, -24);
+        else if(exponent == 0x1f)
+            value = (mantissa == 0) ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+        else
+            value = std::ldexp(mantissa + 1024, exponent - 25);
+
+        return (half & 0x8000) ? -value : value;
+    }
+
+    const std::uint8_t* At(std::size_t offset, std::size_t size) const
+    {
+        if(offset > buffer.size() || buffer.size() - offset < size)
+            throw std::out_of_range("CborSerializer: read past the end of the data");
+
+        return buffer.data() + offset;
+    }
+
+    template<class U>
+    U ReadBigEndian(std::size_t offset) const
+    {
+        const std::uint8_t* in = At(offset, sizeof(U));
+
+        U value = 0;
+        for(std::size_t i = 0; i < sizeof(U); i++)
+            value = static_cast<U>((static_cast<std::uint64_t>(value) << 8) | in[i]);
+
+        return value;
+    }
+
+    //Returns the argument of the head at offset and moves offset past the head.
+    //Indefinite lengths are returned as indefinite, leaving the caller to look for the break
+    std::uint64_t ReadHead(std::size_t& offset, Major& major) const
+    {
+        std::uint8_t type = *At(offset, 1);
+        major = static_cast<Major>(type >> 5);
+        std::uint8_t info = type & 0x1f;
+
+        std::uint64_t argument;
+        switch(info)
+        {
+        case 24: argument = ReadBigEndian<std::uint8_t>(offset + 1); offset += 2; break;
+        case 25: argument = ReadBigEndian<std::uint16_t>(offset + 1); offset += 3; break;
+        case 26: argument = ReadBigEndian<std::uint32_t>(offset + 1); offset += 5; break;
+        case 27: argument = ReadBigEndian<std::uint64_t>(offset + 1); offset += 9; break;
+        case 28: case 29: case 30:
+            throw std::runtime_error("CborSerializer: reserved additional information");
+        default: argument = info; offset += 1; break;
+        }
+
+        if(info == indefinite && (major == Unsigned || major == Negative || major == Tag))
+            throw std::runtime_error("CborSerializer: indefinite length on a type that has no length");
+
+        return argument;
+    }
+
+    bool IsNull(std::size_t offset) const
+    {
+        return *At(offset, 1) == nullByte;
+    }
+
+    template<class T>
+    T ReadNumber(std::size_t offset) const
+    {
+        std::uint8_t type = *At(offset, 1);
+
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            if(type != falseByte && type != trueByte)
+                throw std::runtime_error("CborSerializer: expected a bool");
+
+            return type == trueByte;
+        }
+        else
+        {
+            if(type == halfByte || type == floatByte || type == doubleByte)
+            {
+                if constexpr(!std::is_floating_point_v<T>)
+                {
+                    throw std::runtime_error("CborSerializer: expected an integer");
+                }
+                else if(type == halfByte)
+                {
+                    return static_cast<T>(FromHalf(ReadBigEndian<std::uint16_t>(offset + 1)));
+                }
+                else if(type == floatByte)
+                {
+                    std::uint32_t bits = ReadBigEndian<std::uint32_t>(offset + 1);
+                    float f;
+                    std::memcpy(&f, &bits, sizeof(f));
+                    return static_cast<T>(f);
+                }
+                else
+                {
+                    std::uint64_t bits = ReadBigEndian<std::uint64_t>(offset + 1);
+                    double d;
+                    std::memcpy(&d, &bits, sizeof(d));
+                    return static_cast<T>(d);
+                }
+            }
+
+            Major major;
+            std::uint64_t argument = ReadHead(offset, major);
+            if(major == Unsigned)
+                return Narrow<T>(argument);
+            if(major != Negative)
+                throw std::runtime_error("CborSerializer: expected a number");
+            if(argument > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+                throw std::out_of_range("CborSerializer: integer doesn't fit in the type it's read into");
+
+            return Narrow<T>(-1 - static_cast<std::int64_t>(argument));
+        }
+    }
+
+    //Integers were written in however few bytes they fit in, so check they fit in what they're read into
+    template<class T, class V>
+    static T Narrow(V value)
+    {
+        if constexpr(std::is_integral_v<T>)
+        {
+            bool fits;
+            if constexpr(std::is_signed_v<V>)
+                fits = (value < 0) ? (std::is_signed_v<T> && value >= static_cast<std::int64_t>(std::numeric_limits<T>::min())) :
+                                     static_cast<std::uint64_t>(value) <= static_cast<std::uint64_t>(std::numeric_limits<T>::max());
+            else
+                fits = value <= static_cast<std::uint64_t>(std::numeric_limits<T>::max());
+
+            if(!fits)
+                throw std::out_of_range("CborSerializer: integer doesn't fit in the type it's read into");
+        }
+
+        return static_cast<T>(value);
+    }
+
+    //Returns the definite length text string at offset and moves offset past it
+    std::string_view ReadText(std::size_t& offset) const
+    {
+        Major major;
+        std::size_t head = offset;
+        std::uint64_t size = ReadHead(offset, major);
+        if(major != Text || (*At(head, 1) & 0x1f) == indefinite)
+            throw std::runtime_error("CborSerializer: expected a definite length text string");
+
+        const char* data = reinterpret_cast<const char*>(At(offset, size));
+        offset += size;
+        return std::string_view(data, size);
+    }
+
+    //Appends a byte or text string to out, joining the chunks of an indefinite length one
+    template<class Container>
+    void ReadChunks(std::size_t offset, Major expected, Container& out) const
+    {
+        Major major;
+        bool chunked = (*At(offset, 1) & 0x1f) == indefinite;
+        std::uint64_t size = ReadHead(offset, major);
+        if(major != expected)
+            throw std::runtime_error((expected == Text) ? "CborSerializer: expected a text string" : "CborSerializer: expected a byte string");
+
+        if(!chunked)
+        {
+            const std::uint8_t* data = At(offset, size);
+            std::size_t begin = out.size();
+            out.resize(begin + size);
+            if(size > 0)
+                std::memcpy(out.data() + begin, data, size);
+            return;
+        }
+
+        while(*At(offset, 1) != breakByte)
+        {
+            if((*At(offset, 1) & 0x1f) == indefinite)
+                throw std::runtime_error("CborSerializer: nested indefinite length string");
+
+            ReadChunks(offset, expected, out);
+            offset = SkipItem(offset);
+        }
+    }
+
+    //Returns the number of entries in the map at offset and moves offset to its first entry
+    std::uint32_t ReadMapHead(std::size_t& offset) const
+    {
+        Major major;
+        bool unsized = (*At(offset, 1) & 0x1f) == indefinite;
+        std::uint64_t count = ReadHead(offset, major);
+        if(major != Map)
+            throw std::runtime_error("CborSerializer: expected an object");
+
+        if(unsized)
+        {
+            count = 0;
+            for(std::size_t entry = offset; *At(entry, 1) != breakByte; count++)
+                entry = SkipItem(SkipItem(entry));
+        }
+
+        if(count > std::numeric_limits<std::uint32_t>::max())
+            throw std::out_of_range("CborSerializer: map is too large");
+
+        return static_cast<std::uint32_t>(count);
+    }
+
+    //Returns the number of items in the array at offset and moves offset to its first item
+    std::size_t ReadArrayHead(std::size_t& offset) const
+    {
+        Major major;
+        bool unsized = (*At(offset, 1) & 0x1f) == indefinite;
+        std::uint64_t count = ReadHead(offset, major);
+        if(major != Array)
+            throw std::runtime_error("CborSerializer: expected an array");
+
+        if(unsized)
+        {
+            count = 0;
+            for(std::size_t item = offset; *At(item, 1) != breakByte; count++)
+                item = SkipItem(item);
+        }
+
+        //Every item takes at least a byte, so a count larger than what's left is corrupt
+        if(count > buffer.size() - offset)
+            throw std::out_of_range("CborSerializer: read past the end of the data");
+
+        return static_cast<std::size_t>(count);
+    }
+
+    //Returns the offset just past the data item at offset
+    std::size_t SkipItem(std::size_t offset) const
+    {
+        std::size_t head = offset;
+        Major major;
+        std::uint64_t argument = ReadHead(offset, major);
+        bool unsized = (*At(head, 1) & 0x1f) == indefinite;
+
+        if(unsized)
+        {
+            if(major == Simple)
+                throw std::runtime_error("CborSerializer: unexpected break");
+
+            while(*At(offset, 1) != breakByte)
+                offset = SkipItem(offset);
+            return offset + 1;
+        }
+
+        switch(major)
+        {
+        case Bytes:
+        case Text:
+            At(offset, argument);
+            return offset + argument;
+        case Array:
+            for(std::uint64_t i = 0; i < argument; i++)
+                offset = SkipItem(offset);
+            return offset;
+        case Map:
+            for(std::uint64_t i = 0; i < argument * 2; i++)
+                offset = SkipItem(offset);
+            return offset;
+        case Tag:
+            return SkipItem(offset);
+        default:
+            return offset;
+        }
+    }
+
+    void PushReadFrame(std::size_t offset)
+    {
+        std::uint32_t count = ReadMapHead(offset);
+        readFrames.push_back(ReadFrame{ offset, count, offset, 0 });
+    }
+
+    //Returns the offset of the value of the field called name in the map currently being read
+    std::size_t FindField(std::string_view name)
+    {
+        ReadFrame& frame = (readFrames.empty()) ? rootRead : readFrames.back();
+        if(readFrames.empty())
+            frame.count = writeFrames[0].count;
+
+        std::size_t offset = frame.next;
+        std::uint32_t index = frame.nextIndex;
+        for(std::uint32_t searched = 0; searched < frame.count; searched++)
+        {
+            if(index >= frame.count)
+            {
+                index = 0;
+                offset = frame.begin;
+            }
+
+            std::string_view key = ReadText(offset);
+            std::size_t value = offset;
+            offset = SkipItem(offset);
+            index++;
+
+            if(key == name)
+            {
+                frame.next = offset;
+                frame.nextIndex = index;
+                return value;
+            }
+        }
+
+        throw std::out_of_range("CborSerializer: missing field \"" + std::string(name) + "\"");
+    }
+};
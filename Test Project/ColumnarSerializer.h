@@ -0,0 +1,1336 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include "../Single Include/Serializer.h"
+#include "Varint.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+//Serializer concept
+//Writes collections of records as one column per field instead of one record after the other, so all the x
+//of a std::vector<Bar> are next to each other, then all the y. Each column is then encoded on its own, integers
+//as deltas between neighbours when that's smaller, which is what makes ids, counters and timestamps small.
+//The data is a sequence of named record blocks read back in the order they were written. A single value is
+//a block of one record, SerializeRecords and SerializeColumns write a whole collection as one block.
+//Records don't all need the same fields, null pointers and derived types just leave gaps in the columns they don't use
+class ColumnarSerializer
+{
+public:
+    using serializer_type = ColumnarSerializer;
+    using buffer_type = std::vector<std::uint8_t>;
+
+private:
+    enum class FieldKind : std::uint8_t
+    {
+        Bool,
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float32,
+        Float64,
+        String,         //Values are the lengths, the characters are stored after them
+        Object,         //No values, its fields are the columns whose parent it is
+        NullableObject, //Values are whether each object is there
+        Array           //Values are the lengths, the elements of every array are its field "" one after the other.
+                        //Arrays of objects are an Object or NullableObject field "" whose columns have every element's fields
+    };
+
+    enum class ColumnEncoding : std::uint8_t
+    {
+        Raw,    //Little endian values as wide as their kind
+        Delta   //Zigzagged varints of the difference with the previous value
+    };
+
+    //Parent of a block's top level column, and what a lookup returns for a field the data doesn't have
+    static constexpr std::uint32_t noColumn = std::numeric_limits<std::uint32_t>::max();
+
+    struct Column
+    {
+        std::uint32_t parent = noColumn;
+        std::string name;
+        FieldKind kind = FieldKind::Object;
+        std::uint32_t count = 0;
+
+        //Raw values while writing, or decoded ones while reading if they weren't stored raw
+        std::vector<std::uint8_t> values;
+        std::string characters;
+
+        //Where the raw values and characters are while reading, and how much of them has been read
+        const std::uint8_t* data = nullptr;
+        const char* chars = nullptr;
+        std::size_t charsSize = 0;
+        std::uint32_t cursor = 0;
+        std::size_t charCursor = 0;
+
+        Column() = default;
+
+        Column(std::uint32_t parent, std::string_view name, FieldKind kind, std::uint32_t count = 0) :
+            parent(parent),
+            name(name),
+            kind(kind),
+            count(count)
+        {
+        }
+    };
+
+private:
+    buffer_type buffer;
+    std::size_t readOffset = 0;
+
+    bool inBlock = false;
+    std::vector<Column> columns;
+    std::uint32_t parent = noColumn;
+
+    //The column the nth field of the last record went to, so records with the same fields find theirs straight away
+    std::vector<std::uint32_t> order;
+    std::size_t call = 0;
+
+    std::vector<std::uint8_t> scratch;
+
+    //Leaves the block however it was left
+    struct BlockScope
+    {
+        ColumnarSerializer& serializer;
+
+        ~BlockScope()
+        {
+            serializer.inBlock = false;
+        }
+    };
+
+public:
+    ColumnarSerializer() = default;
+
+    //Creates a serializer holding a copy of bytes which were dumped by a ColumnarSerializer
+    static serializer_type Parse(std::string_view bytes)
+    {
+        serializer_type serializer;
+        serializer.buffer.assign(bytes.begin(), bytes.end());
+        return serializer;
+    }
+
+    static serializer_type Load(std::istream& stream)
+    {
+        serializer_type serializer;
+        serializer.buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        return serializer;
+    }
+
+    static serializer_type LoadFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        if(!stream)
+            throw std::runtime_error("ColumnarSerializer: could not open " + path.string());
+
+        return Load(stream);
+    }
+
+    //Starts reading from the beginning of the data again
+    void Rewind()
+    {
+        readOffset = 0;
+    }
+
+public:
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T value)
+    {
+        if(!inBlock)
+            return SerializeRecords(name, &value, 1);
+
+        Column& column = columns[ColumnFor(name, KindOf<T>())];
+        AppendValue(column.values, value);
+        column.count++;
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T& value)
+    {
+        if(!inBlock)
+            return ReadSingle(name, value);
+
+        std::uint32_t index = FindColumn(name);
+        if(index != noColumn)
+            value = NextValue<T>(columns[index]);
+    }
+
+    //Pointers are a column saying whether each one is null, the values they point to are its field ""
+    template<class P, std::enable_if_t<is_arithmetic_pointer_v<P>, bool> = true>
+    void Serialize(std::string_view name, const P value)
+    {
+        if(!inBlock)
+            return SerializeRecords(name, &value, 1);
+
+        if(OpenNullable(name, value != nullptr))
+        {
+            Serialize("", *value);
+            CloseObject();
+        }
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, char>, bool> = true>
+    void Deserialize(std::string_view name, T*& value)
+    {
+        if(!inBlock)
+            return ReadSingle(name, value);
+
+        bool present;
+        if(!ReadNullable(name, present))
+            return;
+
+        value = nullptr;
+        if(present)
+        {
+            value = new T();
+            Deserialize("", *value);
+            CloseObject();
+        }
+    }
+
+    //Arrays of numbers are a column of their lengths, the numbers of all of them go to its field "" in one go
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Serialize(std::string_view name, const std::vector<T>& values)
+    {
+        if(!inBlock)
+            return SerializeRecords(name, &values, 1);
+
+        WriteArray(name, values.data(), values.size());
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Deserialize(std::string_view name, std::vector<T>& values)
+    {
+        if(!inBlock)
+            return ReadSingle(name, values);
+
+        ReadArray<T>(name, [&](std::uint32_t count)
+        {
+            values.resize(count);
+            return values.data();
+        });
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const std::array<T, N>& values)
+    {
+        if(!inBlock)
+            return SerializeRecords(name, &values, 1);
+
+        WriteArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, std::array<T, N>& values)
+    {
+        if(!inBlock)
+            return ReadSingle(name, values);
+
+        ReadFixedArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T (&values)[N])
+    {
+        if(!inBlock)
+            return SerializeRecords(name, &values, 1);
+
+        WriteArray(name, values, N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T (&values)[N])
+    {
+        if(!inBlock)
+            return ReadSingle(name, values);
+
+        ReadFixedArray(name, values, N);
+    }
+
+    //Strings are values of their own rather than objects with fields
+    void Serialize(std::string_view name, std::string_view value)
+    {
+        if(!inBlock)
+            return SerializeRecords(name, &value, 1);
+
+        if(value.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("ColumnarSerializer: string is too long");
+
+        Column& column = columns[ColumnFor(name, FieldKind::String)];
+        AppendValue(column.values, static_cast<std::uint32_t>(value.size()));
+        column.characters.append(value);
+        column.count++;
+    }
+
+    void Serialize(std::string_view name, const std::string& value)
+    {
+        Serialize(name, std::string_view(value));
+    }
+
+    void Serialize(std::string_view name, const char* value)
+    {
+        Serialize(name, CStringView(name, value));
+    }
+
+    void Deserialize(std::string_view name, std::string& value)
+    {
+        if(!inBlock)
+            return ReadSingle(name, value);
+
+        std::uint32_t index = FindColumn(name);
+        if(index != noColumn)
+            value = NextString(columns[index]);
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T& value)
+    {
+        if(!inBlock)
+            return SerializeRecords(name, &value, 1);
+
+        OpenObject(name);
+        SerializeConstruct<T, serializer_type>::Serialize(*this, value);
+        CloseObject();
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T& value)
+    {
+        if(!inBlock)
+            return ReadSingle(name, value);
+
+        if(ReadObject(name))
+        {
+            SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+            CloseObject();
+        }
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T* value)
+    {
+        if(!inBlock)
+            return SerializeRecords(name, &value, 1);
+
+        if(OpenNullable(name, value != nullptr))
+        {
+            SerializeConstruct<T, serializer_type>::Serialize(*this, *value);
+            CloseObject();
+        }
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T*& value)
+    {
+        if(!inBlock)
+            return ReadSingle(name, value);
+
+        bool present;
+        if(!ReadNullable(name, present))
+            return;
+
+        value = nullptr;
+        if(present)
+        {
+            value = new T();
+            SerializeConstruct<T, serializer_type>::Deserialize(*this, *value);
+            CloseObject();
+        }
+    }
+
+    //Sequences of objects or object pointers are arrays whose elements are objects of the field ""
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Container<T, Rest...>& values)
+    {
+        if(!inBlock)
+            return SerializeRecords(name, &values, 1);
+
+        if(values.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("ColumnarSerializer: array is too long");
+
+        std::uint32_t index = ColumnFor(name, FieldKind::Array);
+        AppendValue(columns[index].values, static_cast<std::uint32_t>(values.size()));
+        columns[index].count++;
+
+        parent = index;
+        for(const T& value : values)
+        {
+            if constexpr(std::is_pointer_v<T>)
+            {
+                if(OpenNullable("", value != nullptr))
+                {
+                    SerializeConstruct<std::remove_pointer_t<T>, serializer_type>::Serialize(*this, *value);
+                    CloseObject();
+                }
+            }
+            else
+            {
+                OpenObject("");
+                SerializeConstruct<T, serializer_type>::Serialize(*this, value);
+                CloseObject();
+            }
+        }
+        CloseObject();
+    }
+
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Container<T, Rest...>& values)
+    {
+        if(!inBlock)
+            return ReadSingle(name, values);
+
+        std::uint32_t index = FindColumn(name);
+        if(index == noColumn)
+            return;
+
+        CheckKind(columns[index], FieldKind::Array);
+        std::uint32_t count = TakeValue<std::uint32_t>(columns[index]);
+
+        //No more elements than the whole column has, whatever the length says
+        std::uint32_t elements = ChildColumn(index, "");
+        std::size_t reserve = (elements == noColumn) ? 0 : columns[elements].count;
+
+        parent = index;
+        EmplaceElements(values, count, [&](T& value)
+        {
+            if constexpr(std::is_pointer_v<T>)
+            {
+                bool present;
+                if(ReadNullable("", present) && present)
+                {
+                    value = new std::remove_pointer_t<T>();
+                    SerializeConstruct<std::remove_pointer_t<T>, serializer_type>::Deserialize(*this, *value);
+                    CloseObject();
+                }
+            }
+            else if(ReadObject(""))
+            {
+                SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+                CloseObject();
+            }
+        }, reserve);
+        CloseObject();
+    }
+
+    //Maps are arrays of { "key", "value" } objects, so the keys and the values of every map share a column each
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Map<Key, Value, Rest...>& values)
+    {
+        if(!inBlock)
+            return SerializeRecords(name, &values, 1);
+
+        if(values.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("ColumnarSerializer: map is too large");
+
+        std::uint32_t index = ColumnFor(name, FieldKind::Array);
+        AppendValue(columns[index].values, static_cast<std::uint32_t>(values.size()));
+        columns[index].count++;
+
+        parent = index;
+        for(const auto& [key, value] : values)
+        {
+            OpenObject("");
+            Serialize("key", key);
+            Serialize("value", value);
+            CloseObject();
+        }
+        CloseObject();
+    }
+
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Map<Key, Value, Rest...>& values)
+    {
+        if(!inBlock)
+            return ReadSingle(name, values);
+
+        std::uint32_t index = FindColumn(name);
+        if(index == noColumn)
+            return;
+
+        CheckKind(columns[index], FieldKind::Array);
+        std::uint32_t count = TakeValue<std::uint32_t>(columns[index]);
+
+        //No more entries than the whole column has, whatever the length says
+        std::uint32_t entries = ChildColumn(index, "");
+        values.clear();
+        ReserveEntries(values, std::min<std::size_t>(count, (entries == noColumn) ? 0 : columns[entries].count));
+
+        parent = index;
+        for(std::uint32_t i = 0; i < count; i++)
+        {
+            if(ReadObject(""))
+            {
+                Key key{};
+                Deserialize("key", key);
+                Deserialize("value", EmplaceEntry(values, key));
+                CloseObject();
+            }
+        }
+        CloseObject();
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolySerialize(std::string_view name, const Derived* value)
+    {
+        if(!inBlock)
+            return WriteRecords(name, 1, [&](std::size_t) { PolySerialize<Base>("", value); });
+
+        if(OpenNullable(name, value != nullptr))
+        {
+            PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Serialize(*this, value);
+            CloseObject();
+        }
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolyDeserialize(std::string_view name, Derived*& value)
+    {
+        if(!inBlock)
+        {
+            ReadRecords(name, [](std::size_t count) { CheckSingle(count); }, [&](std::size_t) { PolyDeserialize<Base>("", value); });
+            return;
+        }
+
+        bool present;
+        if(!ReadNullable(name, present))
+            return;
+
+        value = nullptr;
+        if(present)
+        {
+            PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Deserialize(*this, value);
+            CloseObject();
+        }
+    }
+
+    //Writes count records as one block with a column per field
+    template<class T>
+    void SerializeRecords(std::string_view name, const T* records, std::size_t count)
+    {
+        WriteRecords(name, count, [&](std::size_t i) { Serialize("", records[i]); });
+    }
+
+    template<class T>
+    void SerializeRecords(std::string_view name, const std::vector<T>& records)
+    {
+        SerializeRecords(name, records.data(), records.size());
+    }
+
+    //Rebuilds the records of a block, fields the data doesn't have keep the value T was constructed with
+    template<class T>
+    void DeserializeRecords(std::string_view name, std::vector<T>& records)
+    {
+        ReadRecords(name, [&](std::size_t count) { records.resize(count); }, [&](std::size_t i) { Deserialize("", records[i]); });
+    }
+
+    //Writes a block straight from columns, given as the field's name followed by a vector of its values for every record.
+    //The block reads back as records with those fields
+    template<class... Fields>
+    void SerializeColumns(std::string_view name, const Fields&... fields)
+    {
+        static_assert(sizeof...(Fields) > 0 && sizeof...(Fields) % 2 == 0, "ColumnarSerializer: columns are given as a name followed by its values");
+
+        CheckOutsideBlock();
+        BlockScope scope{ *this };
+        inBlock = true;
+        columns.clear();
+
+        std::uint32_t count = 0;
+        AddColumns(count, fields...);
+        WriteBlock(name, count);
+    }
+
+    //Fills columns of a block straight from the data, given as the field's path, with nested fields separated by
+    //'.', followed by the vector to fill. The path of a block of numbers or strings is ""
+    template<class... Fields>
+    void DeserializeColumns(std::string_view name, Fields&... fields)
+    {
+        static_assert(sizeof...(Fields) > 0 && sizeof...(Fields) % 2 == 0, "ColumnarSerializer: columns are given as a path followed by a vector");
+
+        CheckOutsideBlock();
+        BlockScope scope{ *this };
+        inBlock = true;
+
+        ReadBlock(name);
+        FillColumns(fields...);
+    }
+
+    const buffer_type& Data() const
+    {
+        return buffer;
+    }
+
+    //Blocks are self contained, so other's are just read back after ours
+    void Merge(const serializer_type& other)
+    {
+        buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+    }
+
+    void Merge(serializer_type&& other)
+    {
+        if(buffer.empty())
+            buffer = std::move(other.buffer);
+        else
+            buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+    }
+
+    std::string Dump() const
+    {
+        return std::string(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    }
+
+    void Dump(std::ostream& stream) const
+    {
+        stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    }
+
+private:
+    template<class T>
+    static FieldKind KindOf()
+    {
+        static_assert(!std::is_same_v<T, long double>, "long double has no portable binary representation");
+
+        if constexpr(std::is_same_v<T, bool>)
+            return FieldKind::Bool;
+        else if constexpr(std::is_floating_point_v<T>)
+            return (sizeof(T) == 4) ? FieldKind::Float32 : FieldKind::Float64;
+        else if constexpr(sizeof(T) == 1)
+            return (std::is_signed_v<T>) ? FieldKind::Int8 : FieldKind::UInt8;
+        else if constexpr(sizeof(T) == 2)
+            return (std::is_signed_v<T>) ? FieldKind::Int16 : FieldKind::UInt16;
+        else if constexpr(sizeof(T) == 4)
+            return (std::is_signed_v<T>) ? FieldKind::Int32 : FieldKind::UInt32;
+        else
+            return (std::is_signed_v<T>) ? FieldKind::Int64 : FieldKind::UInt64;
+    }
+
+    //How many bytes a raw value of kind takes
+    static std::size_t WidthOf(FieldKind kind)
+    {
+        switch(kind)
+        {
+        case FieldKind::Int16:
+        case FieldKind::UInt16:
+            return 2;
+        case FieldKind::Int32:
+        case FieldKind::UInt32:
+        case FieldKind::Float32:
+        case FieldKind::String:
+        case FieldKind::Array:
+            return 4;
+        case FieldKind::Int64:
+        case FieldKind::UInt64:
+        case FieldKind::Float64:
+            return 8;
+        case FieldKind::Object:
+            return 0;
+        default:
+            return 1;
+        }
+    }
+
+    void CheckOutsideBlock() const
+    {
+        if(inBlock)
+            throw std::logic_error("ColumnarSerializer: record blocks can't be nested");
+    }
+
+    static void CheckSingle(std::size_t count)
+    {
+        if(count != 1)
+            throw std::runtime_error("ColumnarSerializer: expected a single value, found a block of records");
+    }
+
+    template<class T>
+    void ReadSingle(std::string_view name, T& value)
+    {
+        ReadRecords(name, [](std::size_t count) { CheckSingle(count); }, [&](std::size_t) { Deserialize("", value); });
+    }
+
+    //Looks for the column of the field called name of the current object, trying the one the last record used first
+    std::uint32_t FindColumn(std::string_view name)
+    {
+        if(call < order.size())
+        {
+            std::uint32_t guess = order[call];
+            if(guess != noColumn && columns[guess].parent == parent && columns[guess].name == name)
+            {
+                call++;
+                return guess;
+            }
+        }
+        else
+        {
+            order.resize(call + 1, noColumn);
+        }
+
+        std::uint32_t found = ChildColumn(parent, name);
+        order[call++] = found;
+        return found;
+    }
+
+    std::uint32_t ChildColumn(std::uint32_t of, std::string_view name) const
+    {
+        for(std::uint32_t i = 0; i < columns.size(); i++)
+        {
+            if(columns[i].parent == of && columns[i].name == name)
+                return i;
+        }
+
+        return noColumn;
+    }
+
+    //Finds or adds the column of the field called name of the current object
+    std::uint32_t ColumnFor(std::string_view name, FieldKind kind)
+    {
+        std::uint32_t index = FindColumn(name);
+        if(index == noColumn)
+        {
+            index = static_cast<std::uint32_t>(columns.size());
+            columns.push_back(Column(parent, name, kind));
+            order[call - 1] = index;
+        }
+        else if(columns[index].kind != kind)
+        {
+            throw std::runtime_error("ColumnarSerializer: field \"" + std::string(name) + "\" changed type between records");
+        }
+
+        return index;
+    }
+
+    void OpenObject(std::string_view name)
+    {
+        std::uint32_t index = ColumnFor(name, FieldKind::Object);
+        columns[index].count++;
+        parent = index;
+    }
+
+    //Returns whether the object is there, and if it is its fields go to its columns until CloseObject
+    bool OpenNullable(std::string_view name, bool present)
+    {
+        std::uint32_t index = ColumnFor(name, FieldKind::NullableObject);
+        Column& column = columns[index];
+        AppendValue(column.values, present);
+        column.count++;
+
+        if(present)
+            parent = index;
+
+        return present;
+    }
+
+    void CloseObject()
+    {
+        parent = columns[parent].parent;
+    }
+
+    template<class T>
+    void WriteArray(std::string_view name, const T* values, std::size_t count)
+    {
+        if(count > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("ColumnarSerializer: array is too long");
+
+        std::uint32_t index = ColumnFor(name, FieldKind::Array);
+        AppendValue(columns[index].values, static_cast<std::uint32_t>(count));
+        columns[index].count++;
+
+        parent = index;
+        Column& elements = columns[ColumnFor("", KindOf<T>())];
+
+        std::size_t offset = elements.values.size();
+        elements.values.resize(offset + count * sizeof(T));
+        for(std::size_t i = 0; i < count; i++)
+            StoreValue(elements.values.data() + offset + i * sizeof(T), values[i]);
+        elements.count += static_cast<std::uint32_t>(count);
+
+        CloseObject();
+    }
+
+    //Reads the next array of the field called name into what resize returns for its length, if the data has the field
+    template<class T, class Resize>
+    void ReadArray(std::string_view name, Resize&& resize)
+    {
+        std::uint32_t index = FindColumn(name);
+        if(index == noColumn)
+            return;
+
+        CheckKind(columns[index], FieldKind::Array);
+        std::uint32_t count = TakeValue<std::uint32_t>(columns[index]);
+
+        parent = index;
+        std::uint32_t element = FindColumn("");
+        if(element == noColumn)
+            throw std::runtime_error("ColumnarSerializer: array \"" + std::string(name) + "\" has no values");
+
+        Column& elements = columns[element];
+        CheckKind(elements, KindOf<T>());
+        if(elements.count - elements.cursor < count)
+            throw std::out_of_range("ColumnarSerializer: array \"" + std::string(name) + "\" has fewer values than it's read");
+
+        T* values = resize(count);
+        const std::uint8_t* in = elements.data + std::size_t(elements.cursor) * sizeof(T);
+        for(std::uint32_t i = 0; i < count; i++)
+            values[i] = LoadValue<T>(in + std::size_t(i) * sizeof(T));
+        elements.cursor += count;
+
+        CloseObject();
+    }
+
+    //Arrays that can't be resized must find exactly as many values in the data
+    template<class T>
+    void ReadFixedArray(std::string_view name, T* values, std::size_t count)
+    {
+        ReadArray<T>(name, [&](std::uint32_t size)
+        {
+            if(size != count)
+                throw std::runtime_error("ColumnarSerializer: array \"" + std::string(name) + "\" has " + std::to_string(size) + " values, expected " + std::to_string(count));
+            return values;
+        });
+    }
+
+    //Returns whether the data has the object, and if it does reads its fields from its columns until CloseObject
+    bool ReadObject(std::string_view name)
+    {
+        std::uint32_t index = FindColumn(name);
+        if(index == noColumn)
+            return false;
+
+        CheckKind(columns[index], FieldKind::Object);
+        parent = index;
+        return true;
+    }
+
+    //Returns whether the data has the field, and if it does whether this one is null.
+    //A present value has to be closed with CloseObject
+    bool ReadNullable(std::string_view name, bool& present)
+    {
+        std::uint32_t index = FindColumn(name);
+        if(index == noColumn)
+            return false;
+
+        present = NextValue<bool>(columns[index]);
+        if(present)
+            parent = index;
+
+        return true;
+    }
+
+    void CheckKind(const Column& column, FieldKind kind) const
+    {
+        if(column.kind != kind)
+            throw std::runtime_error("ColumnarSerializer: field \"" + column.name + "\" has a different type than it's read as");
+    }
+
+    template<class T>
+    T NextValue(Column& column)
+    {
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            if(column.kind != FieldKind::Bool && column.kind != FieldKind::NullableObject)
+                CheckKind(column, FieldKind::Bool);
+        }
+        else
+        {
+            CheckKind(column, KindOf<T>());
+        }
+
+        return TakeValue<T>(column);
+    }
+
+    template<class T>
+    T TakeValue(Column& column)
+    {
+        if(column.cursor >= column.count)
+            throw std::out_of_range("ColumnarSerializer: field \"" + column.name + "\" has fewer values than it's read");
+
+        return LoadValue<T>(column.data + std::size_t(column.cursor++) * sizeof(T));
+    }
+
+    //Points into the block's characters, callers assign it into their own string
+    std::string_view NextString(Column& column)
+    {
+        CheckKind(column, FieldKind::String);
+
+        std::uint32_t size = TakeValue<std::uint32_t>(column);
+        if(column.charsSize - column.charCursor < size)
+            throw std::out_of_range("ColumnarSerializer: field \"" + column.name + "\" has fewer characters than it's read");
+
+        std::string_view value(column.chars + column.charCursor, size);
+        column.charCursor += size;
+        return value;
+    }
+
+    template<class T>
+    using BitsOf = std::conditional_t<sizeof(T) == 1, std::uint8_t, std::conditional_t<sizeof(T) == 2, std::uint16_t, std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+    //Shifting each byte in or out is endian independent. Unrolled rather than a loop, which compilers only turn into
+    //a single load or store when it's on its own, not inside the loops that go over a whole column
+    template<class Bits, std::size_t... I>
+    static void StoreBits(std::uint8_t* out, Bits bits, std::index_sequence<I...>)
+    {
+        ((out[I] = static_cast<std::uint8_t>(bits >> (I * 8))), ...);
+    }
+
+    template<class Bits, std::size_t... I>
+    static Bits LoadBits(const std::uint8_t* in, std::index_sequence<I...>)
+    {
+        return static_cast<Bits>((static_cast<Bits>(static_cast<Bits>(in[I]) << (I * 8)) | ...));
+    }
+
+    //Appends the little endian bytes of value
+    template<class T>
+    static void AppendValue(std::vector<std::uint8_t>& values, const T value)
+    {
+        std::size_t offset = values.size();
+        values.resize(offset + sizeof(T));
+        StoreValue(values.data() + offset, value);
+    }
+
+    template<class T>
+    static void StoreValue(std::uint8_t* out, const T value)
+    {
+        using Bits = BitsOf<T>;
+        Bits bits;
+        if constexpr(std::is_same_v<T, bool>)
+            bits = value ? 1 : 0;
+        else
+            std::memcpy(&bits, &value, sizeof(T));
+
+        StoreBits(out, bits, std::make_index_sequence<sizeof(T)>());
+    }
+
+    template<class T>
+    static T LoadValue(const std::uint8_t* in)
+    {
+        using Bits = BitsOf<T>;
+        Bits bits = LoadBits<Bits>(in, std::make_index_sequence<sizeof(T)>());
+
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            return bits != 0;
+        }
+        else
+        {
+            T value;
+            std::memcpy(&value, &bits, sizeof(T));
+            return value;
+        }
+    }
+
+    //Runs each for every record between the start of a block and writing it out
+    template<class Each>
+    void WriteRecords(std::string_view name, std::size_t count, Each&& each)
+    {
+        CheckOutsideBlock();
+        if(count > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("ColumnarSerializer: too many records");
+
+        BlockScope scope{ *this };
+        inBlock = true;
+        columns.clear();
+        order.clear();
+
+        for(std::size_t i = 0; i < count; i++)
+        {
+            call = 0;
+            parent = noColumn;
+            each(i);
+
+            //Records mostly look like the first one
+            if(i == 0)
+            {
+                for(Column& column : columns)
+                    column.values.reserve(column.values.size() * count);
+            }
+        }
+
+        WriteBlock(name, static_cast<std::uint32_t>(count));
+    }
+
+    //Reads the next block, hands its record count to start and then runs each for every record
+    template<class Start, class Each>
+    void ReadRecords(std::string_view name, Start&& start, Each&& each)
+    {
+        CheckOutsideBlock();
+        BlockScope scope{ *this };
+        inBlock = true;
+
+        std::uint32_t count = ReadBlock(name);
+        start(count);
+
+        order.clear();
+        for(std::uint32_t i = 0; i < count; i++)
+        {
+            call = 0;
+            parent = noColumn;
+            each(i);
+        }
+    }
+
+    template<class U, class... Rest>
+    void AddColumns(std::uint32_t& count, std::string_view name, const std::vector<U>& values, const Rest&... rest)
+    {
+        if(columns.empty())
+        {
+            if(values.size() > std::numeric_limits<std::uint32_t>::max())
+                throw std::length_error("ColumnarSerializer: too many records");
+
+            //Every column is a field of the records, which are objects
+            count = static_cast<std::uint32_t>(values.size());
+            columns.push_back(Column(noColumn, "", FieldKind::Object, count));
+        }
+        else if(values.size() != count)
+        {
+            throw std::invalid_argument("ColumnarSerializer: columns of a block must all have as many values as there are records");
+        }
+
+        order.clear();
+        call = 0;
+        parent = 0;
+        for(const U& value : values)
+        {
+            call = 0;
+            Serialize(name, value);
+        }
+
+        if constexpr(sizeof...(Rest) > 0)
+            AddColumns(count, rest...);
+    }
+
+    template<class U, class... Rest>
+    void FillColumns(std::string_view path, std::vector<U>& values, Rest&... rest)
+    {
+        FillColumn(path, values);
+
+        if constexpr(sizeof...(Rest) > 0)
+            FillColumns(rest...);
+    }
+
+    template<class U>
+    void FillColumn(std::string_view path, std::vector<U>& values)
+    {
+        //Walks down from the block's top level column one name at a time
+        std::uint32_t index = ChildColumn(noColumn, "");
+        std::string_view rest = path;
+        while(index != noColumn && !rest.empty())
+        {
+            std::size_t dot = rest.find('.');
+            index = ChildColumn(index, rest.substr(0, dot));
+            rest = (dot == std::string_view::npos) ? std::string_view() : rest.substr(dot + 1);
+        }
+
+        if(index == noColumn)
+            throw std::runtime_error("ColumnarSerializer: block has no field \"" + std::string(path) + "\"");
+
+        Column& column = columns[index];
+        values.resize(column.count);
+        if constexpr(std::is_same_v<U, std::string>)
+        {
+            for(std::string& value : values)
+                value = NextString(column);
+        }
+        else
+        {
+            CheckKind(column, KindOf<U>());
+
+            //Contiguous and a fixed width, compilers turn this into wide loads
+            for(std::size_t i = 0; i < values.size(); i++)
+                values[i] = LoadValue<U>(column.data + i * sizeof(U));
+        }
+    }
+
+    void WriteBlock(std::string_view name, std::uint32_t count)
+    {
+        WriteString(name);
+        WriteUnsigned(count);
+        WriteUnsigned(static_cast<std::uint32_t>(columns.size()));
+
+        for(const Column& column : columns)
+        {
+            WriteUnsigned(column.parent);
+            WriteString(column.name);
+            WriteUnsigned(static_cast<std::uint8_t>(column.kind));
+
+            ColumnEncoding encoding = ColumnEncoding::Raw;
+            if(EncodeDelta(column))
+                encoding = ColumnEncoding::Delta;
+
+            const std::vector<std::uint8_t>& values = (encoding == ColumnEncoding::Delta) ? scratch : column.values;
+            WriteUnsigned(static_cast<std::uint8_t>(encoding));
+            WriteUnsigned(column.count);
+            WriteUnsigned(static_cast<std::uint64_t>(values.size()));
+            buffer.insert(buffer.end(), values.begin(), values.end());
+
+            if(column.kind == FieldKind::String)
+            {
+                WriteUnsigned(static_cast<std::uint64_t>(column.characters.size()));
+                buffer.insert(buffer.end(), column.characters.begin(), column.characters.end());
+            }
+        }
+    }
+
+    //Delta encodes the column into scratch, and returns whether that's smaller than its raw values
+    bool EncodeDelta(const Column& column)
+    {
+        switch(column.kind)
+        {
+        case FieldKind::Int16: return EncodeDelta<std::int16_t>(column);
+        case FieldKind::UInt16: return EncodeDelta<std::uint16_t>(column);
+        case FieldKind::Int32: return EncodeDelta<std::int32_t>(column);
+        case FieldKind::UInt32:
+        case FieldKind::String:
+        case FieldKind::Array: return EncodeDelta<std::uint32_t>(column);
+        case FieldKind::Int64: return EncodeDelta<std::int64_t>(column);
+        case FieldKind::UInt64: return EncodeDelta<std::uint64_t>(column);
+        default: return false;
+        }
+    }
+
+    template<class T>
+    bool EncodeDelta(const Column& column)
+    {
+        using U = std::make_unsigned_t<T>;
+        using S = std::make_signed_t<T>;
+
+        //Gives up as soon as it's no smaller than the raw values
+        std::size_t limit = column.values.size();
+        scratch.resize(limit + Varint::maxSize<S>);
+
+        std::size_t size = 0;
+        U previous = 0;
+        for(std::uint32_t i = 0; i < column.count && size < limit; i++)
+        {
+            U value = LoadValue<U>(column.values.data() + std::size_t(i) * sizeof(T));
+            size += Varint::Encode(static_cast<S>(static_cast<U>(value - previous)), scratch.data() + size);
+            previous = value;
+        }
+
+        scratch.resize(size);
+        return size < limit;
+    }
+
+    //Reads the next block's columns, and returns how many records it has
+    std::uint32_t ReadBlock(std::string_view name)
+    {
+        if(ReadString() != name)
+            throw std::runtime_error("ColumnarSerializer: expected records \"" + std::string(name) + "\"");
+
+        std::uint32_t count = ReadUnsigned<std::uint32_t>();
+        std::uint32_t columnCount = ReadUnsigned<std::uint32_t>();
+
+        //A column's header is its parent, name length, type, encoding, count and size before anything else,
+        //so a column count the rest of the data can't hold is corrupt and isn't allocated for
+        constexpr std::size_t columnHeaderSize = 4 + 4 + 1 + 1 + 4 + 8;
+        if(columnCount > (buffer.size() - readOffset) / columnHeaderSize)
+            throw std::out_of_range("ColumnarSerializer: block has more columns than the data can hold");
+
+        columns.resize(columnCount);
+        for(Column& column : columns)
+        {
+            column.parent = ReadUnsigned<std::uint32_t>();
+            column.name = ReadString();
+            column.kind = static_cast<FieldKind>(ReadUnsigned<std::uint8_t>());
+            auto encoding = static_cast<ColumnEncoding>(ReadUnsigned<std::uint8_t>());
+            column.count = ReadUnsigned<std::uint32_t>();
+            column.cursor = 0;
+            column.charCursor = 0;
+
+            if(column.parent != noColumn && column.parent >= columnCount)
+                throw std::runtime_error("ColumnarSerializer: column refers to a parent which doesn't exist");
+            if(column.kind > FieldKind::Array)
+                throw std::runtime_error("ColumnarSerializer: column has an unknown type");
+
+            std::size_t size = ReadSize();
+            const std::uint8_t* values = ReadBytes(size);
+            std::size_t rawSize = std::size_t(column.count) * WidthOf(column.kind);
+            if(encoding == ColumnEncoding::Raw)
+            {
+                if(size != rawSize)
+                    throw std::runtime_error("ColumnarSerializer: column \"" + column.name + "\" has the wrong size");
+
+                column.data = values;
+            }
+            else if(encoding == ColumnEncoding::Delta)
+            {
+                DecodeDelta(column, values, size);
+                column.data = column.values.data();
+            }
+            else
+            {
+                throw std::runtime_error("ColumnarSerializer: column has an unknown encoding");
+            }
+
+            if(column.kind == FieldKind::String)
+            {
+                column.charsSize = ReadSize();
+                column.chars = reinterpret_cast<const char*>(ReadBytes(column.charsSize));
+            }
+        }
+
+        CheckRecordCount(count);
+        return count;
+    }
+
+    //Every record has a value in each top level column, so a record count none of them has is corrupt.
+    //Objects have no values of their own, their counts are checked against their fields' columns
+    void CheckRecordCount(std::uint32_t count) const
+    {
+        if(columns.empty())
+        {
+            if(count > buffer.size() - readOffset)
+                throw std::out_of_range("ColumnarSerializer: block has more records than the data can hold");
+            return;
+        }
+
+        //Fields are always added after the object they're in, so going backwards sees every field before its object
+        std::vector<std::uint32_t> counts(columns.size(), 0);
+        std::vector<bool> hasFields(columns.size(), false);
+        std::uint32_t most = 0;
+        for(std::size_t i = columns.size(); i-- > 0;)
+        {
+            const Column& column = columns[i];
+            if(column.kind == FieldKind::Object && hasFields[i] && column.count > counts[i])
+                throw std::out_of_range("ColumnarSerializer: object \"" + column.name + "\" has more values than its fields");
+
+            counts[i] = column.count;
+
+            if(column.parent == noColumn)
+            {
+                most = std::max(most, counts[i]);
+            }
+            else if(columns[column.parent].kind == FieldKind::Object)
+            {
+                counts[column.parent] = std::max(counts[column.parent], counts[i]);
+                hasFields[column.parent] = true;
+            }
+        }
+
+        if(count > most)
+            throw std::out_of_range("ColumnarSerializer: block has more records than its columns have values");
+    }
+
+    void DecodeDelta(Column& column, const std::uint8_t* in, std::size_t size)
+    {
+        switch(column.kind)
+        {
+        case FieldKind::Int16: return DecodeDelta<std::int16_t>(column, in, size);
+        case FieldKind::UInt16: return DecodeDelta<std::uint16_t>(column, in, size);
+        case FieldKind::Int32: return DecodeDelta<std::int32_t>(column, in, size);
+        case FieldKind::UInt32:
+        case FieldKind::String:
+        case FieldKind::Array: return DecodeDelta<std::uint32_t>(column, in, size);
+        case FieldKind::Int64: return DecodeDelta<std::int64_t>(column, in, size);
+        case FieldKind::UInt64: return DecodeDelta<std::uint64_t>(column, in, size);
+        default:
+            throw std::runtime_error("ColumnarSerializer: column \"" + column.name + "\" can't be delta encoded");
+        }
+    }
+
+    template<class T>
+    void DecodeDelta(Column& column, const std::uint8_t* in, std::size_t size)
+    {
+        using U = std::make_unsigned_t<T>;
+        using S = std::make_signed_t<T>;
+
+        //Every varint is at least a byte
+        if(column.count > size)
+            throw std::out_of_range("ColumnarSerializer: column \"" + column.name + "\" has fewer values than it says");
+
+        //The deltas are decoded in bulk into the column's values, then summed up in place
+        column.values.resize(std::size_t(column.count) * sizeof(T));
+        std::vector<S> deltas(column.count);
+        if(Varint::DecodeBulk(in, in + size, deltas.data(), deltas.size()) != size)
+            throw std::runtime_error("ColumnarSerializer: column \"" + column.name + "\" has the wrong size");
+
+        U previous = 0;
+        for(std::uint32_t i = 0; i < column.count; i++)
+        {
+            previous = static_cast<U>(previous + static_cast<U>(deltas[i]));
+            StoreValue(column.values.data() + std::size_t(i) * sizeof(T), previous);
+        }
+    }
+
+    template<class U>
+    void WriteUnsigned(U value)
+    {
+        std::size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(U));
+        StoreValue(buffer.data() + offset, value);
+    }
+
+    template<class U>
+    U ReadUnsigned()
+    {
+        return LoadValue<U>(ReadBytes(sizeof(U)));
+    }
+
+    std::size_t ReadSize()
+    {
+        std::uint64_t size = ReadUnsigned<std::uint64_t>();
+        if(size > buffer.size() - readOffset)
+            throw std::out_of_range("ColumnarSerializer: read past the end of the data");
+
+        return static_cast<std::size_t>(size);
+    }
+
+    const std::uint8_t* ReadBytes(std::size_t size)
+    {
+        if(buffer.size() - readOffset < size)
+            throw std::out_of_range("ColumnarSerializer: read past the end of the data");
+
+        const std::uint8_t* bytes = buffer.data() + readOffset;
+        readOffset += size;
+        return bytes;
+    }
+
+    void WriteString(std::string_view string)
+    {
+        if(string.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("ColumnarSerializer: string is too long");
+
+        WriteUnsigned(static_cast<std::uint32_t>(string.size()));
+        buffer.insert(buffer.end(), string.begin(), string.end());
+    }
+
+    std::string_view ReadString()
+    {
+        std::size_t size = ReadUnsigned<std::uint32_t>();
+        return std::string_view(reinterpret_cast<const char*>(ReadBytes(size)), size);
+    }
+};
@@ -0,0 +1,209 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CRC32C_X86
+#include <nmmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//Same as ByteSwap, the SSE4.2 kernel is compiled for it on its own so the rest of the program doesn't need it
+#if defined(CRC32C_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CRC32C_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CRC32C_TARGET(isa)
+#endif
+
+//CRC32C (Castagnoli polynomial), the checksum iSCSI, ext4 and most record logs use.
+//x86 has had an instruction for it since SSE4.2, which is used when the CPU has it. Otherwise it's slicing by 8,
+//eight lookup tables folding in 8 bytes per step
+class Crc32c
+{
+public:
+    enum class Kernel
+    {
+        Slicing8,
+        Sse42
+    };
+
+    //Checksum of size bytes. Passing an earlier result as crc continues it, so checksumming in pieces gives the same result
+    static std::uint32_t Compute(const void* data, std::size_t size, std::uint32_t crc = 0)
+    {
+        return ~Selected().compute(static_cast<const std::uint8_t*>(data), size, ~crc);
+    }
+
+    static Kernel SelectedKernel()
+    {
+        return Selected().kernel;
+    }
+
+    //Whether this CPU can run kernel
+    static bool Supports(Kernel kernel)
+    {
+        static const Kernel best = Detect();
+        return kernel <= best;
+    }
+
+    //Makes Compute use kernel from now on, for testing and benchmarking the one this machine wouldn't pick.
+    //Returns false and changes nothing if the CPU can't run it. Not safe while other threads are checksumming
+    static bool Select(Kernel kernel)
+    {
+        if(!Supports(kernel))
+            return false;
+
+        Selected() = TableOf(kernel);
+        return true;
+    }
+
+private:
+    using ComputeFunction = std::uint32_t(*)(const std::uint8_t* data, std::size_t size, std::uint32_t crc);
+
+    struct Table
+    {
+        Kernel kernel;
+        ComputeFunction compute;
+    };
+
+    //Reflected form of 0x1EDC6F41
+    static constexpr std::uint32_t polynomial = 0x82F63B78u;
+
+    //lookup[0] is the usual byte at a time table, lookup[k] advances lookup[0]'s entries by k more zero bytes
+    struct Lookup
+    {
+        std::uint32_t values[8][256];
+    };
+
+    static constexpr Lookup MakeLookup()
+    {
+        Lookup lookup = {};
+        for(std::uint32_t i = 0; i < 256; i++)
+        {
+            std::uint32_t crc = i;
+            for(int bit = 0; bit < 8; bit++)
+                crc = (crc >> 1) ^ ((crc & 1) ? polynomial : 0);
+            lookup.values[0][i] = crc;
+        }
+
+        for(std::size_t k = 1; k < 8; k++)
+        {
+            for(std::size_t i = 0; i < 256; i++)
+                lookup.values[k][i] = (lookup.values[k - 1][i] >> 8) ^ lookup.values[0][lookup.values[k - 1][i] & 0xFF];
+        }
+        return lookup;
+    }
+
+    //Built at compile time. A function static, since the class isn't complete yet where a static member would be
+    static const Lookup& Tables()
+    {
+        static constexpr Lookup lookup = MakeLookup();
+        return lookup;
+    }
+
+    static Table& Selected()
+    {
+        static Table table = TableOf(Detect());
+        return table;
+    }
+
+    static Table TableOf(Kernel kernel)
+    {
+#ifdef CRC32C_X86
+        if(kernel == Kernel::Sse42)
+            return Table{ kernel, ComputeSse42 };
+#endif
+        return Table{ Kernel::Slicing8, ComputeSlicing8 };
+    }
+
+    static Kernel Detect()
+    {
+#if defined(CRC32C_X86) && !defined(_MSC_VER)
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("sse4.2"))
+            return Kernel::Sse42;
+#elif defined(CRC32C_X86)
+        int info[4];
+        __cpuid(info, 1);
+        if(info[2] & (1 << 20))
+            return Kernel::Sse42;
+#endif
+        return Kernel::Slicing8;
+    }
+
+    //Little endian whatever the machine, the tables are built for bytes in stream order
+    static std::uint32_t Load32(const std::uint8_t* bytes)
+    {
+        return std::uint32_t(bytes[0]) | (std::uint32_t(bytes[1]) << 8) | (std::uint32_t(bytes[2]) << 16) | (std::uint32_t(bytes[3]) << 24);
+    }
+
+    static std::uint32_t ComputeSlicing8(const std::uint8_t* data, std::size_t size, std::uint32_t crc)
+    {
+        const auto& t = Tables().values;
+        for(; size >= 8; size -= 8, data += 8)
+        {
+            std::uint32_t low = Load32(data) ^ crc;
+            std::uint32_t high = Load32(data + 4);
+            crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+                  t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        }
+
+        for(; size > 0; size--, data++)
+            crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+        return crc;
+    }
+
+#ifdef CRC32C_X86
+    CRC32C_TARGET("sse4.2")
+    static std::uint32_t ComputeSse42(const std::uint8_t* data, std::size_t size, std::uint32_t crc)
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        std::uint64_t wide = crc;
+        for(; size >= 8; size -= 8, data += 8)
+        {
+            std::uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            wide = _mm_crc32_u64(wide, value);
+        }
+        crc = static_cast<std::uint32_t>(wide);
+#endif
+        for(; size >= 4; size -= 4, data += 4)
+        {
+            std::uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            crc = _mm_crc32_u32(crc, value);
+        }
+
+        for(; size > 0; size--, data++)
+            crc = _mm_crc32_u8(crc, *data);
+        return crc;
+    }
+#endif
+};
@@ -0,0 +1,367 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//Map stored as one contiguous vector of key/value pairs kept sorted by key.
+//Small maps are searched linearly, bigger ones with a binary search.
+//Has the interface nlohmann::basic_json needs of its ObjectType, and iterates in the same order as std::map.
+//Compare must be transparent so lookups can use anything comparable to Key without converting it first
+template<class Key, class T, class Compare = std::less<>, class Allocator = std::allocator<std::pair<const Key, T>>>
+class FlatMap
+{
+private:
+    using Element = std::pair<Key, T>;
+    using Container = std::vector<Element, typename std::allocator_traits<Allocator>::template rebind_alloc<Element>>;
+
+    //Iterates the sorted vector, but only hands out the key as const so nothing can break the order lookups depend on.
+    //Like std::vector<bool>, dereferencing gives a proxy rather than a real reference
+    template<bool Const>
+    class Iterator
+    {
+    private:
+        using Base = std::conditional_t<Const, typename Container::const_iterator, typename Container::iterator>;
+        using Mapped = std::conditional_t<Const, const T, T>;
+
+    public:
+        struct Reference
+        {
+            const Key& first;
+            Mapped& second;
+
+            operator std::pair<const Key, T>() const { return { first, second }; }
+        };
+
+        struct Pointer
+        {
+            Reference reference;
+
+            const Reference* operator->() const { return &reference; }
+        };
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<const Key, T>;
+        using difference_type = typename Container::difference_type;
+        using pointer = Pointer;
+        using reference = Reference;
+
+    public:
+        Iterator() = default;
+
+        //iterator converts to const_iterator
+        template<bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) :
+            it(other.it)
+        {
+        }
+
+        Reference operator*() const { return { it->first, it->second }; }
+        Pointer operator->() const { return { **this }; }
+        Reference operator[](difference_type offset) const { return *(*this + offset); }
+
+        Iterator& operator++() { ++it; return *this; }
+        Iterator operator++(int) { return Iterator(it++); }
+        Iterator& operator--() { --it; return *this; }
+        Iterator operator--(int) { return Iterator(it--); }
+        Iterator& operator+=(difference_type offset) { it += offset; return *this; }
+        Iterator& operator-=(difference_type offset) { it -= offset; return *this; }
+
+        friend Iterator operator+(Iterator iterator, difference_type offset) { return iterator += offset; }
+        friend Iterator operator+(difference_type offset, Iterator iterator) { return iterator += offset; }
+        friend Iterator operator-(Iterator iterator, difference_type offset) { return iterator -= offset; }
+        friend difference_type operator-(const Iterator& a, const Iterator& b) { return a.it - b.it; }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a.it == b.it; }
+        friend bool operator!=(const Iterator& a, const Iterator& b) { return a.it != b.it; }
+        friend bool operator<(const Iterator& a, const Iterator& b) { return a.it < b.it; }
+        friend bool operator>(const Iterator& a, const Iterator& b) { return a.it > b.it; }
+        friend bool operator<=(const Iterator& a, const Iterator& b) { return a.it <= b.it; }
+        friend bool operator>=(const Iterator& a, const Iterator& b) { return a.it >= b.it; }
+
+    private:
+        explicit Iterator(Base it) :
+            it(it)
+        {
+        }
+
+    private:
+        Base it;
+
+        friend class FlatMap;
+        friend class Iterator<!Const>;
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using size_type = typename Container::size_type;
+    using difference_type = typename Container::difference_type;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    //Up to this many elements a linear scan beats a binary search
+    static constexpr size_type linearSearchLimit = 8;
+
+public:
+    FlatMap() = default;
+
+    explicit FlatMap(const Allocator& allocator) :
+        elements(allocator)
+    {
+    }
+
+    template<class InputIt>
+    FlatMap(InputIt first, InputIt last, const Allocator& allocator = Allocator()) :
+        elements(allocator)
+    {
+        insert(first, last);
+    }
+
+    FlatMap(std::initializer_list<value_type> init, const Allocator& allocator = Allocator()) :
+        FlatMap(init.begin(), init.end(), allocator)
+    {
+    }
+
+    iterator begin() noexcept { return iterator(elements.begin()); }
+    const_iterator begin() const noexcept { return const_iterator(elements.begin()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(elements.end()); }
+    const_iterator end() const noexcept { return const_iterator(elements.end()); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    bool empty() const noexcept { return elements.empty(); }
+    size_type size() const noexcept { return elements.size(); }
+    size_type max_size() const noexcept { return elements.max_size(); }
+    size_type capacity() const noexcept { return elements.capacity(); }
+    void reserve(size_type capacity) { elements.reserve(capacity); }
+    void shrink_to_fit() { elements.shrink_to_fit(); }
+    void clear() noexcept { elements.clear(); }
+    allocator_type get_allocator() const { return allocator_type(elements.get_allocator()); }
+    void swap(FlatMap& other) noexcept { elements.swap(other.elements); }
+
+    template<class K>
+    iterator find(const K& key)
+    {
+        return iterator(Find(elements, key));
+    }
+
+    template<class K>
+    const_iterator find(const K& key) const
+    {
+        return const_iterator(Find(elements, key));
+    }
+
+    template<class K>
+    size_type count(const K& key) const
+    {
+        return (find(key) != end()) ? 1 : 0;
+    }
+
+    T& at(const Key& key)
+    {
+        auto it = find(key);
+        if(it == end())
+            throw std::out_of_range("FlatMap: key not found");
+
+        return it->second;
+    }
+
+    const T& at(const Key& key) const
+    {
+        auto it = find(key);
+        if(it == end())
+            throw std::out_of_range("FlatMap: key not found");
+
+        return it->second;
+    }
+
+    T& operator[](const Key& key)
+    {
+        return emplace(key).first->second;
+    }
+
+    T& operator[](Key&& key)
+    {
+        return emplace(std::move(key)).first->second;
+    }
+
+    template<class K, class... Args>
+    std::pair<iterator, bool> emplace(K&& key, Args&&... args)
+    {
+        auto it = LowerBound(elements, key);
+        if(it != elements.end() && !Less(key, it->first))
+            return { iterator(it), false };
+
+        it = elements.emplace(it, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+        return { iterator(it), true };
+    }
+
+    //emplace already leaves an existing key's value alone
+    template<class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+    {
+        return emplace(std::forward<K>(key), std::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return emplace(value.first, std::move(value.second));
+    }
+
+    template<class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for(; first != last; ++first)
+        {
+            const auto& element = *first;
+            emplace(element.first, element.second);
+        }
+    }
+
+    iterator erase(const_iterator position)
+    {
+        return iterator(elements.erase(position.it));
+    }
+
+    iterator erase(iterator position)
+    {
+        return iterator(elements.erase(position.it));
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return iterator(elements.erase(first.it, last.it));
+    }
+
+    size_type erase(const Key& key)
+    {
+        auto it = Find(elements, key);
+        if(it == elements.end())
+            return 0;
+
+        elements.erase(it);
+        return 1;
+    }
+
+    //Same as std::map::merge, moves every element whose key isn't in this map out of source
+    //and leaves the rest behind. Linear, both sides are already sorted
+    void merge(FlatMap& source)
+    {
+        Container merged(elements.get_allocator());
+        Container leftovers(source.elements.get_allocator());
+        merged.reserve(elements.size() + source.elements.size());
+
+        auto ours = elements.begin();
+        auto theirs = source.elements.begin();
+        while(ours != elements.end() && theirs != source.elements.end())
+        {
+            if(Less(ours->first, theirs->first))
+            {
+                merged.push_back(std::move(*ours++));
+            }
+            else if(Less(theirs->first, ours->first))
+            {
+                merged.push_back(std::move(*theirs++));
+            }
+            else
+            {
+                merged.push_back(std::move(*ours++));
+                leftovers.push_back(std::move(*theirs++));
+            }
+        }
+        std::move(ours, elements.end(), std::back_inserter(merged));
+        std::move(theirs, source.elements.end(), std::back_inserter(merged));
+
+        elements.swap(merged);
+        source.elements.swap(leftovers);
+    }
+
+    friend bool operator==(const FlatMap& a, const FlatMap& b) { return a.elements == b.elements; }
+    friend bool operator!=(const FlatMap& a, const FlatMap& b) { return a.elements != b.elements; }
+    friend bool operator<(const FlatMap& a, const FlatMap& b) { return a.elements < b.elements; }
+    friend bool operator>(const FlatMap& a, const FlatMap& b) { return a.elements > b.elements; }
+    friend bool operator<=(const FlatMap& a, const FlatMap& b) { return a.elements <= b.elements; }
+    friend bool operator>=(const FlatMap& a, const FlatMap& b) { return a.elements >= b.elements; }
+
+private:
+    //Compare is stateless, so we don't spend any space on it per map
+    template<class A, class B>
+    static bool Less(const A& a, const B& b)
+    {
+        return Compare{}(a, b);
+    }
+
+    template<class Elements, class K>
+    static auto LowerBound(Elements& elements, const K& key)
+    {
+        if(elements.size() <= linearSearchLimit)
+        {
+            auto it = elements.begin();
+            while(it != elements.end() && Less(it->first, key))
+                ++it;
+
+            return it;
+        }
+
+        return std::lower_bound(elements.begin(), elements.end(), key, [](const Element& element, const K& k)
+        {
+            return Less(element.first, k);
+        });
+    }
+
+    template<class Elements, class K>
+    static auto Find(Elements& elements, const K& key)
+    {
+        auto it = LowerBound(elements, key);
+        return (it != elements.end() && !Less(key, it->first)) ? it : elements.end();
+    }
+
+private:
+    Container elements;
+};
@@ -24,5 +24,15 @@ SOFTWARE.
 */
 #include "Foo.h"
 #include "JsonSerializer.h"
+#include "BinarySerializer.h"
+#include "MsgPackSerializer.h"
+#include "CborSerializer.h"
+#include "ZeroCopySerializer.h"
+#include "ColumnarSerializer.h"
 
-REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Foo, JsonSerializer);
\ No newline at end of file
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Foo, JsonSerializer);
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Foo, BinarySerializer);
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Foo, MsgPackSerializer);
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Foo, CborSerializer);
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Foo, ZeroCopySerializer);
+REGISTER_POLYMORPHIC_SERIALIZE_FUNCTIONS(Foo, Foo, ColumnarSerializer);
\ No newline at end of file
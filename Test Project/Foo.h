@@ -23,7 +23,7 @@ SOFTWARE.
 
 */
 #pragma once
-#include "JsonSerializer.h"
+#include "../Single Include/Serializer.h"
 
 struct Foo
 {
@@ -33,8 +33,8 @@ struct Foo
 };
 
 
-template<>
-struct SerializeConstruct<Foo, JsonSerializer>
+template<class SerializerT>
+struct SerializeConstruct<Foo, SerializerT>
 {
     using value_type = Foo;
     using pointer = Foo*;
@@ -43,7 +43,9 @@ struct SerializeConstruct<Foo, JsonSerializer>
     using const_pointer = const Foo*;
     using const_reference = const Foo&;
 
-    using serializer_type = JsonSerializer;
+    using serializer_type = SerializerT;
+
+    static constexpr std::size_t field_count = 1;
 
     static void Serialize(serializer_type& serializer, const_reference& v)
     {
@@ -25,21 +25,125 @@ SOFTWARE.
 #pragma once
 #include "../Single Include/Serializer.h"
 #include "json.hpp"
+#include "MappedFile.h"
+#include "MonotonicArena.h"
+#include "FlatMap.h"
 #include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 //Serializer concept
-class JsonSerializer
+//Json is the nlohmann::basic_json used for the DOM, so its allocator and object storage can be swapped out
+template<class Json = nlohmann::json>
+class BasicJsonSerializer
 {
 public:
-    using serializer_type = JsonSerializer;
+    using serializer_type = BasicJsonSerializer;
+    using json_type = Json;
+    using object_type = typename json_type::object_t;
+
+    //What Deserialize does when the field it's asked for isn't in the document
+    enum class MissingField
+    {
+        Throw,  //Throws std::out_of_range naming the missing field
+        Skip    //Leaves the value untouched
+    };
+
+    //What Merge does when both serializers have a value under the same name.
+    //For deep merges objects present in both are merged instead of conflicting
+    enum class MergeConflict
+    {
+        KeepExisting,
+        Overwrite,
+        Throw       //Throws std::runtime_error naming the conflicting field
+    };
+
+    enum class DumpFormat
+    {
+        Compact,
+        Indented
+    };
+
+    //Streaming dumps never hold more than this much of the output in memory at once
+    static constexpr std::size_t dumpBufferSize = 64 * 1024;
+    static constexpr unsigned int dumpIndent = 2;
 
 private:
-    nlohmann::json json{};
+    json_type json{};
     std::vector<std::string_view> tree;
 
-private:
-    friend struct SerializeConstruct<std::string, serializer_type>;
+    //Cursors to the json object of every name in tree, kept in sync with it so
+    //we don't have to walk from the root on every field
+    std::vector<json_type*> cursors;
+
+    //Reads never go through operator[], so they don't insert anything into the document
+    //they're reading from. When document is null we read back our own json
+    const json_type* document = nullptr;
+    std::vector<const json_type*> readCursors;
+
+    MissingField missingField = MissingField::Throw;
+
+public:
+    BasicJsonSerializer() = default;
+
+    //Creates a serializer which deserializes straight out of document without copying or modifying it.
+    //document must outlive the serializer. Give each thread its own reader and they can all
+    //deserialize from the same document at once
+    static serializer_type Reader(const json_type& document, MissingField missingField = MissingField::Throw)
+    {
+        serializer_type reader;
+        reader.document = &document;
+        reader.missingField = missingField;
+        return reader;
+    }
+
+    void SetMissingFieldPolicy(MissingField policy)
+    {
+        missingField = policy;
+    }
+
+    //Creates a serializer holding the parsed contents of text
+    static serializer_type Parse(std::string_view text)
+    {
+        serializer_type serializer;
+        serializer.json = json_type::parse(text.begin(), text.end());
+        return serializer;
+    }
+
+    static serializer_type Load(std::istream& stream)
+    {
+        serializer_type serializer;
+        serializer.json = json_type::parse(stream);
+        return serializer;
+    }
 
+    static serializer_type LoadFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        if(!stream)
+            throw std::runtime_error("JsonSerializer: could not open " + path.string());
+
+        return Load(stream);
+    }
+
+    //Parses straight out of a read only mapping of the file instead of reading it into memory first
+    static serializer_type LoadMapped(const std::filesystem::path& path)
+    {
+        MappedFile file(path, MappedFile::Access::Sequential);
+        return Parse(file.View());
+    }
 
 public:
     //The following functions must exist unless specified
@@ -55,11 +159,12 @@ public:
     void Deserialize(std::string_view name, T& value)
     {
         //For built in types
-        value = JsonReference(name);
+        if(auto field = FindReference(name))
+            value = *field;
     }
 
-    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
-    void Serialize(std::string_view name, const T* value)
+    template<class P, std::enable_if_t<is_arithmetic_pointer_v<P>, bool> = true>
+    void Serialize(std::string_view name, const P value)
     {
         if(value == nullptr)
         {
@@ -71,33 +176,105 @@ public:
         }
     }
 
-    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, char>, bool> = true>
     void Deserialize(std::string_view name, T*& value)
     {
-        using value_type = std::remove_pointer_t<T>;
-        auto ref = JsonReference(name);
+        if(auto field = FindReference(name))
+            value = (field->is_null()) ? nullptr : new T(*field);
+    }
+
+    //Strings are values of their own rather than objects with fields
+    void Serialize(std::string_view name, std::string_view value)
+    {
+        JsonReference(name) = typename json_type::string_t(value);
+    }
+
+    void Serialize(std::string_view name, const std::string& value)
+    {
+        Serialize(name, std::string_view(value));
+    }
+
+    void Serialize(std::string_view name, const char* value)
+    {
+        Serialize(name, CStringView(name, value));
+    }
+
+    void Deserialize(std::string_view name, std::string& value)
+    {
+        auto field = FindReference(name);
+        if(field == nullptr)
+            return;
+
+        if(!field->is_string())
+            throw std::runtime_error("JsonSerializer: \"" + FieldPath(name) + "\" is not a string");
+
+        //Copied straight into value's own buffer rather than through a temporary string
+        value = field->template get_ref<const typename json_type::string_t&>();
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Serialize(std::string_view name, const std::vector<T>& values)
+    {
+        SerializeArray(name, values.data(), values.size());
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Deserialize(std::string_view name, std::vector<T>& values)
+    {
+        if(auto field = FindArray(name))
+        {
+            values.resize(field->size());
+            ReadArray(*field, values.data());
+        }
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const std::array<T, N>& values)
+    {
+        SerializeArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, std::array<T, N>& values)
+    {
+        DeserializeArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T (&values)[N])
+    {
+        SerializeArray(name, values, N);
+    }
 
-        value = (ref.is_null()) ? nullptr : new T(ref);
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T (&values)[N])
+    {
+        DeserializeArray(name, values, N);
     }
 
     template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
     void Serialize(std::string_view name, const T& value)
     {
-        tree.push_back(name);
+        PushNode(name);
+        Reserve(serialize_field_count_v<T, serializer_type>);
 
         SerializeConstruct<T, serializer_type>::Serialize(*this, value);
 
-        tree.pop_back();
+        PopNode();
     }
 
     template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
     void Deserialize(std::string_view name, T& value)
     {
-        tree.push_back(name);
+        auto field = FindReference(name);
+        if(field == nullptr)
+            return;
+
+        PushReadNode(name, field);
 
         SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
 
-        tree.pop_back();
+        PopReadNode();
     }
 
     template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
@@ -109,31 +286,160 @@ public:
         }
         else
         {
-            tree.push_back(name);
+            PushNode(name);
+            Reserve(serialize_field_count_v<T, serializer_type>);
 
             SerializeConstruct<T, serializer_type>::Serialize(*this, *value);
 
-            tree.pop_back();
+            PopNode();
         }
     }
 
     template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
     void Deserialize(std::string_view name, T*& value)
     {
-        auto ref = JsonReference(name);
+        auto field = FindReference(name);
+        if(field == nullptr)
+            return;
 
-        if(ref.is_null())
+        if(field->is_null())
         {
             value = nullptr;
         }
         else
         {
-            tree.push_back(name);
+            PushReadNode(name, field);
 
             value = new T();
             SerializeConstruct<T, serializer_type>::Deserialize(*this, *value);
 
-            tree.pop_back();
+            PopReadNode();
+        }
+    }
+
+    //Sequences of objects or object pointers are json arrays, null for the null pointers
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Container<T, Rest...>& values)
+    {
+        json_type& node = JsonReference(name);
+        node = json_type::array();
+
+        auto& array = node.template get_ref<typename json_type::array_t&>();
+        array.reserve(values.size());
+        for(const T& value : values)
+        {
+            if constexpr(std::is_pointer_v<T>)
+            {
+                if(value == nullptr)
+                {
+                    array.emplace_back(nullptr);
+                    continue;
+                }
+            }
+
+            array.emplace_back(json_type::object());
+            cursors.push_back(&array.back());
+            tree.push_back(name);
+            if constexpr(std::is_pointer_v<T>)
+                WriteElement(*value);
+            else
+                WriteElement(value);
+            PopNode();
+        }
+    }
+
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Container<T, Rest...>& values)
+    {
+        auto field = FindArray(name);
+        if(field == nullptr)
+            return;
+
+        auto element = field->begin();
+        EmplaceElements(values, field->size(), [&](T& value)
+        {
+            const json_type* node = &*element++;
+            if constexpr(std::is_pointer_v<T>)
+            {
+                if(node->is_null())
+                    return;
+
+                value = new std::remove_pointer_t<T>();
+            }
+
+            PushReadNode(name, node);
+            if constexpr(std::is_pointer_v<T>)
+                SerializeConstruct<std::remove_pointer_t<T>, serializer_type>::Deserialize(*this, *value);
+            else
+                SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+            PopReadNode();
+        });
+    }
+
+    //Maps keyed by strings are objects with a field per entry, any other map is an array of { "key", "value" } objects
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Map<Key, Value, Rest...>& values)
+    {
+        if constexpr(std::is_same_v<Key, std::string>)
+        {
+            PushNode(name);
+            JsonReference() = json_type::object();
+            Reserve(values.size());
+
+            for(const auto& [key, value] : values)
+                Serialize(key, value);
+
+            PopNode();
+        }
+        else
+        {
+            json_type& node = JsonReference(name);
+            node = json_type::array();
+
+            auto& array = node.template get_ref<typename json_type::array_t&>();
+            array.reserve(values.size());
+            for(const auto& [key, value] : values)
+            {
+                array.emplace_back(json_type::object());
+                cursors.push_back(&array.back());
+                tree.push_back(name);
+                Reserve(2);
+                Serialize("key", key);
+                Serialize("value", value);
+                PopNode();
+            }
+        }
+    }
+
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Map<Key, Value, Rest...>& values)
+    {
+        const json_type* field = (std::is_same_v<Key, std::string>) ? FindReference(name) : FindArray(name);
+        if(field == nullptr)
+            return;
+
+        if(std::is_same_v<Key, std::string> && !field->is_object())
+            throw std::runtime_error("JsonSerializer: \"" + FieldPath(name) + "\" is not an object");
+
+        values.clear();
+        ReserveEntries(values, field->size());
+        if constexpr(std::is_same_v<Key, std::string>)
+        {
+            PushReadNode(name, field);
+            for(auto it = field->begin(); it != field->end(); ++it)
+                Deserialize(it.key(), EmplaceEntry(values, it.key()));
+            PopReadNode();
+        }
+        else
+        {
+            for(const json_type& entry : *field)
+            {
+                PushReadNode(name, &entry);
+                Key key{};
+                Deserialize("key", key);
+                Deserialize("value", EmplaceEntry(values, key));
+                PopReadNode();
+            }
         }
     }
 
@@ -146,82 +452,607 @@ public:
         }
         else
         {
-            tree.push_back(name);
+            PushNode(name);
 
             PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Serialize(*this, value);
 
-            tree.pop_back();
+            PopNode();
         }
     }
 
     template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
     void PolyDeserialize(std::string_view name, Derived*& value)
     {
-        auto ref = JsonReference(name);
+        auto field = FindReference(name);
+        if(field == nullptr)
+            return;
 
-        if(ref.is_null())
+        if(field->is_null())
         {
             value = nullptr;
         }
         else
         {
-            tree.push_back(name);
+            PushReadNode(name, field);
 
             PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Deserialize(*this, value);
 
-            tree.pop_back();
+            PopReadNode();
         }
     }
 
-    nlohmann::json::const_reference Data() const
+    const json_type& Data() const
     {
         return json;
     }
 
-    void Merge(const serializer_type& type)
+    void Merge(const serializer_type& type, MergeConflict conflict = MergeConflict::KeepExisting, bool deep = false)
     {
-        json.insert(type.json.begin(), type.json.end());
+        if(type.json.is_object())
+            MergeObjects(Object(json), type.json.template get_ref<const object_type&>(), conflict, deep);
     }
 
-    std::string Dump() const
+    //Moves type's values over instead of copying them, type is left holding whatever wasn't merged
+    void Merge(serializer_type&& type, MergeConflict conflict = MergeConflict::KeepExisting, bool deep = false)
     {
-        return json.dump();
+        if(type.json.is_object())
+            MergeObjects(Object(json), std::move(type.json.template get_ref<object_type&>()), conflict, deep);
+    }
+
+    void DeepMerge(const serializer_type& type, MergeConflict conflict = MergeConflict::KeepExisting)
+    {
+        Merge(type, conflict, true);
+    }
+
+    void DeepMerge(serializer_type&& type, MergeConflict conflict = MergeConflict::KeepExisting)
+    {
+        Merge(std::move(type), conflict, true);
+    }
+
+    //Merges every serializer in [first, last) in order. Pass move iterators to move their values over
+    template<class Iterator>
+    void MergeAll(Iterator first, Iterator last, MergeConflict conflict = MergeConflict::KeepExisting, bool deep = false)
+    {
+        //Object storage which can reserve gets sized for every top level value up front
+        if constexpr(HasReserve<object_type>::value && std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>)
+        {
+            object_type& object = Object(json);
+            std::size_t size = object.size();
+            for(Iterator it = first; it != last; ++it)
+                size += (*it).Data().size();
+
+            object.reserve(size);
+        }
+
+        for(; first != last; ++first)
+            Merge(*first, conflict, deep);
+    }
+
+    std::string Dump(DumpFormat format = DumpFormat::Compact) const
+    {
+        return (format == DumpFormat::Indented) ? json.dump(dumpIndent) : json.dump();
+    }
+
+    void Dump(std::ostream& stream, DumpFormat format = DumpFormat::Compact) const
+    {
+        DumpTo([&stream](const char* data, std::size_t size)
+        {
+            stream.write(data, static_cast<std::streamsize>(size));
+        }, format);
+    }
+
+    void Dump(std::FILE* file, DumpFormat format = DumpFormat::Compact) const
+    {
+        DumpTo([file](const char* data, std::size_t size)
+        {
+            if(std::fwrite(data, 1, size, file) != size)
+                throw std::system_error(errno, std::generic_category(), "JsonSerializer::Dump");
+        }, format);
+    }
+
+    void Dump(int fileDescriptor, DumpFormat format = DumpFormat::Compact) const
+    {
+        DumpTo([fileDescriptor](const char* data, std::size_t size)
+        {
+            while(size > 0)
+            {
+#ifdef _WIN32
+                auto written = _write(fileDescriptor, data, static_cast<unsigned int>(size));
+#else
+                auto written = write(fileDescriptor, data, size);
+                if(written < 0 && errno == EINTR)
+                    continue;
+#endif
+                if(written < 0)
+                    throw std::system_error(errno, std::generic_category(), "JsonSerializer::Dump");
+
+                data += written;
+                size -= static_cast<std::size_t>(written);
+            }
+        }, format);
     }
 
 private:
-    nlohmann::json::reference JsonReference(std::string_view name)
+    //The streaming dumps rely on nlohmann's internals, written against json.hpp 3.9.1. They only go through these two:
+    //output_adapter_t, the pointer json::dump's serializer writes characters through, and the serializer itself, constructed in DumpTo.
+    //BasicJsonStreamLoader::Handler::DomParser is the only other internal this file uses, check all three when upgrading json.hpp
+    using OutputAdapter = nlohmann::detail::output_adapter_t<char>;
+    using JsonWriter = nlohmann::detail::serializer<json_type>;
+
+    //Collects the dump in a fixed size buffer and hands it to Sink one full buffer at a time
+    template<class Sink>
+    class BufferedOutput : public OutputAdapter::element_type
     {
-        return JsonReference()[name.data()];
+    private:
+        Sink sink;
+        std::array<char, dumpBufferSize> buffer;
+        std::size_t size = 0;
+
+    public:
+        BufferedOutput(Sink sink) :
+            sink(std::move(sink))
+        {
+        }
+
+        void write_character(char c) override
+        {
+            if(size == buffer.size())
+                Flush();
+
+            buffer[size++] = c;
+        }
+
+        void write_characters(const char* s, std::size_t length) override
+        {
+            if(size + length > buffer.size())
+            {
+                Flush();
+
+                //Bigger than the whole buffer, no point copying it in
+                if(length > buffer.size())
+                {
+                    sink(s, length);
+                    return;
+                }
+            }
+
+            std::copy(s, s + length, buffer.data() + size);
+            size += length;
+        }
+
+        void Flush()
+        {
+            if(size > 0)
+                sink(buffer.data(), size);
+
+            size = 0;
+        }
+    };
+
+    template<class Sink>
+    void DumpTo(Sink sink, DumpFormat format) const
+    {
+        auto output = std::make_shared<BufferedOutput<Sink>>(std::move(sink));
+
+        JsonWriter writer(OutputAdapter(output), ' ');
+        writer.dump(json, format == DumpFormat::Indented, false, dumpIndent);
+
+        output->Flush();
     }
 
-    nlohmann::json::reference JsonReference()
+    json_type& JsonReference(std::string_view name)
     {
-        if(tree.size() == 0)
+        json_type& node = JsonReference();
+
+        //json's object comparator is transparent, so we can look up straight from the string_view
+        //and only build a key when the field doesn't exist yet
+        auto it = node.find(name);
+        if(it != node.end())
+            return *it;
+
+        return *node.emplace(std::string(name), nullptr).first;
+    }
+
+    json_type& JsonReference()
+    {
+        if(cursors.size() == 0)
             return json;
 
-        nlohmann::json::pointer j = &json[tree[0].data()];
-        for(auto n = tree.begin() + 1; n != tree.end(); n++)
+        return *cursors.back();
+    }
+
+    void PushNode(std::string_view name)
+    {
+        cursors.push_back(&JsonReference(name));
+        tree.push_back(name);
+    }
+
+    void PopNode()
+    {
+        cursors.pop_back();
+        tree.pop_back();
+    }
+
+    //Sizes the object on top of the cursor stack for the fields about to be written into it
+    void Reserve(std::size_t fieldCount)
+    {
+        if constexpr(HasReserve<object_type>::value)
         {
-            j = &((*j)[n->data()]);
+            if(fieldCount > 0)
+                Object(JsonReference()).reserve(fieldCount);
         }
+    }
+
+    const json_type& ReadReference() const
+    {
+        if(readCursors.size() == 0)
+            return (document) ? *document : json;
+
+        return *readCursors.back();
+    }
+
+    //Builds the json array in place, reserved for every value up front
+    template<class T>
+    void SerializeArray(std::string_view name, const T* values, std::size_t count)
+    {
+        json_type& node = JsonReference(name);
+        node = json_type::array();
+
+        auto& array = node.template get_ref<typename json_type::array_t&>();
+        array.reserve(count);
+        for(std::size_t i = 0; i < count; i++)
+            array.emplace_back(values[i]);
+    }
+
+    //Fills in the object on top of the cursor stack
+    template<class T>
+    void WriteElement(const T& value)
+    {
+        Reserve(serialize_field_count_v<T, serializer_type>);
+        SerializeConstruct<T, serializer_type>::Serialize(*this, value);
+    }
+
+    //Arrays that can't be resized must find exactly as many values in the document
+    template<class T>
+    void DeserializeArray(std::string_view name, T* values, std::size_t count)
+    {
+        auto field = FindArray(name);
+        if(field == nullptr)
+            return;
+
+        if(field->size() != count)
+            throw std::runtime_error("JsonSerializer: \"" + FieldPath(name) + "\" has " + std::to_string(field->size()) + " values, expected " + std::to_string(count));
+
+        ReadArray(*field, values);
+    }
+
+    template<class T>
+    static void ReadArray(const json_type& field, T* values)
+    {
+        for(const json_type& value : field.template get_ref<const typename json_type::array_t&>())
+            *values++ = value.template get<T>();
+    }
+
+    const json_type* FindArray(std::string_view name) const
+    {
+        auto field = FindReference(name);
+        if(field != nullptr && !field->is_array())
+            throw std::runtime_error("JsonSerializer: \"" + FieldPath(name) + "\" is not an array");
+
+        return field;
+    }
+
+    //Returns nullptr if the field is missing and the policy is to skip it
+    const json_type* FindReference(std::string_view name) const
+    {
+        const json_type& node = ReadReference();
 
-        return *j;
+        auto it = node.find(name);
+        if(it != node.end())
+            return &*it;
+
+        if(missingField == MissingField::Skip)
+            return nullptr;
+
+        throw std::out_of_range("JsonSerializer: missing field \"" + FieldPath(name) + "\"");
+    }
+
+    //Dotted path from the root to name, for error messages
+    std::string FieldPath(std::string_view name) const
+    {
+        std::string path;
+        for(std::string_view n : tree)
+        {
+            path.append(n);
+            path += '.';
+        }
+        path.append(name);
+
+        return path;
+    }
+
+    static object_type& Object(json_type& value)
+    {
+        if(value.is_null())
+            value = json_type::object();
+
+        return value.template get_ref<object_type&>();
+    }
+
+    void MergeObjects(object_type& destination, const object_type& source, MergeConflict conflict, bool deep)
+    {
+        for(const auto& [name, value] : source)
+        {
+            auto [it, inserted] = destination.emplace(name, value);
+            if(!inserted)
+                MergeConflicting(it->first, it->second, value, conflict, deep);
+        }
+    }
+
+    void MergeObjects(object_type& destination, object_type&& source, MergeConflict conflict, bool deep)
+    {
+        //Splices every non conflicting node over without copying or allocating anything,
+        //only the conflicts are left behind in source
+        destination.merge(source);
+
+        for(auto&& [name, value] : source)
+            MergeConflicting(name, destination.find(name)->second, std::move(value), conflict, deep);
+    }
+
+    template<class Source>
+    void MergeConflicting(std::string_view name, json_type& destination, Source&& source, MergeConflict conflict, bool deep)
+    {
+        if(deep && destination.is_object() && source.is_object())
+        {
+            tree.push_back(name);
+
+            auto& destinationObject = destination.template get_ref<object_type&>();
+            if constexpr(std::is_const_v<std::remove_reference_t<Source>>)
+                MergeObjects(destinationObject, source.template get_ref<const object_type&>(), conflict, deep);
+            else
+                MergeObjects(destinationObject, std::move(source.template get_ref<object_type&>()), conflict, deep);
+
+            tree.pop_back();
+            return;
+        }
+
+        switch(conflict)
+        {
+        case MergeConflict::KeepExisting:
+            break;
+        case MergeConflict::Overwrite:
+            destination = std::forward<Source>(source);
+            break;
+        case MergeConflict::Throw:
+            throw std::runtime_error("JsonSerializer: merge conflict on \"" + FieldPath(name) + "\"");
+        }
+    }
+
+    void PushReadNode(std::string_view name, const json_type* node)
+    {
+        readCursors.push_back(node);
+        tree.push_back(name);
+    }
+
+    void PopReadNode()
+    {
+        readCursors.pop_back();
+        tree.pop_back();
     }
 };
 
 
-//TODO: Figure out an interface to support containers for any kind of format without having to touch
-//The class to basically do what is done below.
-template<>
-struct SerializeConstruct<std::string, JsonSerializer>
+using JsonSerializer = BasicJsonSerializer<>;
+
+//Builds its DOM in the calling thread's MonotonicArena. Destroy the serializer, then
+//MonotonicArena::ThreadLocal().Reset() releases the whole DOM at once
+using ArenaJsonSerializer = BasicJsonSerializer<nlohmann::basic_json<std::map, std::vector, std::string, bool, std::int64_t, std::uint64_t, double, ArenaAllocator>>;
+
+//Stores objects in one sorted vector each instead of a std::map, which is much smaller and faster
+//for the narrow objects most types serialize to. Dumps the exact same text as JsonSerializer
+using FlatJsonSerializer = BasicJsonSerializer<nlohmann::basic_json<FlatMap>>;
+
+
+//Loads a document without ever building a DOM of the whole thing.
+//Fields are bound up front with the same calls you'd make on a JsonSerializer, then Load drives
+//nlohmann's SAX parser and only builds a DOM for the top level field currently being parsed.
+//As soon as that field closes it's deserialized into its bound object and thrown away, so
+//peak memory is the largest top level field rather than the whole document.
+//Fields which aren't bound are skipped without being built, bound fields missing from the
+//document are left untouched
+template<class SerializerT>
+class BasicJsonStreamLoader
 {
-    static void Serialize(JsonSerializer& serializer, const std::string& v)
+public:
+    using serializer_type = SerializerT;
+    using json_type = typename serializer_type::json_type;
+
+private:
+    using DeserializeFunction = std::function<void(serializer_type&, std::string_view)>;
+
+    std::unordered_map<std::string, DeserializeFunction> fields;
+
+public:
+    template<class T>
+    void Deserialize(std::string_view name, T& value)
+    {
+        fields[std::string(name)] = [&value](serializer_type& serializer, std::string_view name)
+        {
+            serializer.Deserialize(name, value);
+        };
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolyDeserialize(std::string_view name, Derived*& value)
+    {
+        fields[std::string(name)] = [&value](serializer_type& serializer, std::string_view name)
+        {
+            serializer.template PolyDeserialize<Base>(name, value);
+        };
+    }
+
+    void Load(std::string_view text) const
     {
-        serializer.JsonReference() = v;
+        Handler handler(*this);
+        json_type::sax_parse(text.begin(), text.end(), &handler);
     }
 
-    static void Deserialize(JsonSerializer& serializer, std::string& v)
+    void Load(std::istream& stream) const
     {
-        v = serializer.JsonReference();
+        Handler handler(*this);
+        json_type::sax_parse(stream, &handler);
     }
+
+    void LoadFile(const std::filesystem::path& path) const
+    {
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        if(!stream)
+            throw std::runtime_error("JsonStreamLoader: could not open " + path.string());
+
+        Load(stream);
+    }
+
+    void LoadMapped(const std::filesystem::path& path) const
+    {
+        MappedFile file(path, MappedFile::Access::Sequential);
+        Load(file.View());
+    }
+
+private:
+    class Handler
+    {
+    private:
+        //nlohmann's internal SAX to DOM builder, written against json.hpp 3.9.1 like BasicJsonSerializer's OutputAdapter and JsonWriter
+        using DomParser = nlohmann::detail::json_sax_dom_parser<json_type>;
+
+        const BasicJsonStreamLoader& loader;
+
+        //0 is outside of the root object, 1 is directly inside it
+        std::size_t depth = 0;
+
+        std::string fieldName;
+        const DeserializeFunction* field = nullptr;
+        json_type value;
+        std::optional<DomParser> dom;
+
+    public:
+        Handler(const BasicJsonStreamLoader& loader) :
+            loader(loader)
+        {
+        }
+
+        bool null() { return Value([](DomParser& dom) { return dom.null(); }); }
+        bool boolean(bool v) { return Value([v](DomParser& dom) { return dom.boolean(v); }); }
+        bool number_integer(typename json_type::number_integer_t v) { return Value([v](DomParser& dom) { return dom.number_integer(v); }); }
+        bool number_unsigned(typename json_type::number_unsigned_t v) { return Value([v](DomParser& dom) { return dom.number_unsigned(v); }); }
+        bool number_float(typename json_type::number_float_t v, const typename json_type::string_t& s) { return Value([&](DomParser& dom) { return dom.number_float(v, s); }); }
+        bool string(typename json_type::string_t& v) { return Value([&v](DomParser& dom) { return dom.string(v); }); }
+        bool binary(typename json_type::binary_t& v) { return Value([&v](DomParser& dom) { return dom.binary(v); }); }
+
+        bool start_object(std::size_t elements)
+        {
+            if(depth++ == 0)
+                return true;
+
+            return !dom || dom->start_object(elements);
+        }
+
+        bool key(typename json_type::string_t& name)
+        {
+            if(depth > 1)
+                return !dom || dom->key(name);
+
+            auto it = loader.fields.find(name);
+            if(it == loader.fields.end())
+            {
+                field = nullptr;
+                dom.reset();
+                return true;
+            }
+
+            fieldName = std::move(name);
+            field = &it->second;
+            value = nullptr;
+            dom.emplace(value);
+            return true;
+        }
+
+        bool end_object()
+        {
+            return End([](DomParser& dom) { return dom.end_object(); });
+        }
+
+        bool start_array(std::size_t elements)
+        {
+            if(depth++ == 0)
+                ThrowRootNotObject();
+
+            return !dom || dom->start_array(elements);
+        }
+
+        bool end_array()
+        {
+            return End([](DomParser& dom) { return dom.end_array(); });
+        }
+
+        template<class Exception>
+        bool parse_error(std::size_t, const std::string&, const Exception& ex)
+        {
+            throw ex;
+        }
+
+    private:
+        [[noreturn]] static void ThrowRootNotObject()
+        {
+            throw std::runtime_error("JsonStreamLoader: the root of the document must be an object");
+        }
+
+        template<class Forward>
+        bool Value(Forward forward)
+        {
+            if(depth == 0)
+                ThrowRootNotObject();
+
+            if(dom && !forward(*dom))
+                return false;
+
+            if(depth == 1)
+                FinishField();
+
+            return true;
+        }
+
+        template<class Forward>
+        bool End(Forward forward)
+        {
+            if(--depth == 0)
+                return true;
+
+            if(dom && !forward(*dom))
+                return false;
+
+            if(depth == 1)
+                FinishField();
+
+            return true;
+        }
+
+        void FinishField()
+        {
+            if(field == nullptr)
+                return;
+
+            //Wrap the field in an object of its own so it can be read back by name
+            json_type document = json_type::object();
+            document.emplace(fieldName, std::move(value));
+
+            serializer_type reader = serializer_type::Reader(document);
+            (*field)(reader, fieldName);
+
+            field = nullptr;
+            dom.reset();
+        }
+    };
 };
+
+using JsonStreamLoader = BasicJsonStreamLoader<JsonSerializer>;
@@ -0,0 +1,200 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include <cerrno>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//Read only memory mapping of a whole file, so parsers can read it in place
+//instead of copying it into a string first
+class MappedFile
+{
+public:
+    //Hint to the OS about how the mapping is going to be read
+    enum class Access
+    {
+        Sequential,
+        Random
+    };
+
+private:
+    const char* data = nullptr;
+    std::size_t size = 0;
+
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::filesystem::path& path, Access access = Access::Sequential)
+    {
+#ifdef _WIN32
+        DWORD flags = (access == Access::Sequential) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+        if(file == INVALID_HANDLE_VALUE)
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "MappedFile: could not open " + path.string());
+
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(file, &fileSize))
+        {
+            Close();
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "MappedFile: could not read the size of " + path.string());
+        }
+        size = static_cast<std::size_t>(fileSize.QuadPart);
+
+        //Empty files can't be mapped, leave data null and size 0
+        if(size == 0)
+            return;
+
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mapping != nullptr)
+            data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+        if(data == nullptr)
+        {
+            auto error = GetLastError();
+            Close();
+            throw std::system_error(static_cast<int>(error), std::system_category(), "MappedFile: could not map " + path.string());
+        }
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            throw std::system_error(errno, std::generic_category(), "MappedFile: could not open " + path.string());
+
+        struct stat info;
+        if(fstat(fd, &info) != 0)
+        {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "MappedFile: could not read the size of " + path.string());
+        }
+        size = static_cast<std::size_t>(info.st_size);
+
+        if(size > 0)
+        {
+            void* region = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(region == MAP_FAILED)
+            {
+                int error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(), "MappedFile: could not map " + path.string());
+            }
+
+            //Only a hint, failing it doesn't matter
+            madvise(region, size, (access == Access::Sequential) ? MADV_SEQUENTIAL : MADV_RANDOM);
+            data = static_cast<const char*>(region);
+        }
+
+        //The mapping keeps the file alive on its own
+        close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+    {
+        Swap(other);
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        if(this != &other)
+        {
+            Close();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+        Close();
+    }
+
+    const char* Data() const
+    {
+        return data;
+    }
+
+    std::size_t Size() const
+    {
+        return size;
+    }
+
+    std::string_view View() const
+    {
+        return std::string_view(data, size);
+    }
+
+private:
+    void Swap(MappedFile& other) noexcept
+    {
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+#ifdef _WIN32
+        std::swap(file, other.file);
+        std::swap(mapping, other.mapping);
+#endif
+    }
+
+    void Close() noexcept
+    {
+#ifdef _WIN32
+        if(data != nullptr)
+            UnmapViewOfFile(data);
+        if(mapping != nullptr)
+            CloseHandle(mapping);
+        if(file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#else
+        if(data != nullptr)
+            munmap(const_cast<char*>(data), size);
+#endif
+        data = nullptr;
+        size = 0;
+    }
+};
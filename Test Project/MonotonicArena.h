@@ -0,0 +1,159 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+//Bump allocator which never frees individual allocations, everything is released at once by Reset.
+//Blocks are kept around after a Reset so the next frame's allocations don't go back to the heap
+class MonotonicArena
+{
+public:
+    static constexpr std::size_t defaultBlockSize = 64 * 1024;
+
+private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t current = 0;
+    std::size_t offset = 0;
+    std::size_t blockSize;
+
+public:
+    explicit MonotonicArena(std::size_t blockSize = defaultBlockSize) :
+        blockSize(blockSize)
+    {
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    //Each thread gets its own arena so allocating never needs a lock
+    static MonotonicArena& ThreadLocal()
+    {
+        thread_local MonotonicArena arena;
+        return arena;
+    }
+
+    void* Allocate(std::size_t size, std::size_t alignment)
+    {
+        for(; current < blocks.size(); current++, offset = 0)
+        {
+            if(void* memory = Bump(blocks[current], size, alignment))
+                return memory;
+        }
+
+        std::size_t newSize = std::max(blocks.empty() ? blockSize : blocks.back().size * 2, size + alignment);
+        blocks.push_back({ std::make_unique<std::byte[]>(newSize), newSize });
+        current = blocks.size() - 1;
+        offset = 0;
+
+        return Bump(blocks.back(), size, alignment);
+    }
+
+    //Everything allocated from the arena is invalid after this, destroy whatever lives in it first
+    void Reset()
+    {
+        current = 0;
+        offset = 0;
+    }
+
+    //Reset, and hand every block back to the heap
+    void Release()
+    {
+        blocks.clear();
+        Reset();
+    }
+
+    std::size_t Capacity() const
+    {
+        std::size_t capacity = 0;
+        for(const Block& block : blocks)
+            capacity += block.size;
+
+        return capacity;
+    }
+
+private:
+    void* Bump(Block& block, std::size_t size, std::size_t alignment)
+    {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block.memory.get()) + offset;
+        std::size_t padding = (alignment - address % alignment) % alignment;
+
+        if(block.size - offset < padding || block.size - offset - padding < size)
+            return nullptr;
+
+        offset += padding + size;
+        return reinterpret_cast<void*>(address + padding);
+    }
+};
+
+//Stateless allocator handing out memory from the calling thread's MonotonicArena.
+//Deallocating does nothing, memory comes back when the arena is Reset
+template<class T>
+struct ArenaAllocator
+{
+    using value_type = T;
+
+    ArenaAllocator() = default;
+
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_array_new_length();
+
+        return static_cast<T*>(MonotonicArena::ThreadLocal().Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept
+    {
+    }
+
+    template<class U>
+    bool operator==(const ArenaAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+
+    template<class U>
+    bool operator!=(const ArenaAllocator<U>&) const noexcept
+    {
+        return false;
+    }
+};
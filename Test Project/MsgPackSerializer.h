@@ -0,0 +1,975 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include "../Single Include/Serializer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+//Serializer concept
+//Encodes MessagePack straight into a byte buffer as values are serialized, and decodes straight out of it,
+//without ever building a DOM. Objects are maps keyed by field name, the whole serializer is one root map.
+//Integers and floats always get the smallest encoding that holds their value exactly
+class MsgPackSerializer
+{
+public:
+    using serializer_type = MsgPackSerializer;
+    using buffer_type = std::vector<std::uint8_t>;
+
+private:
+    //A map being written. Its header is patched in once we know how many fields it has
+    struct WriteFrame
+    {
+        std::size_t headerOffset;
+        std::size_t headerSize;
+        std::uint32_t count;
+    };
+
+    //A map being read. Fields are searched for starting after the last one found, so reading them
+    //in the order they were written never has to look at the same entry twice
+    struct ReadFrame
+    {
+        std::size_t begin;
+        std::uint32_t count;
+        std::size_t next;
+        std::uint32_t nextIndex;
+    };
+
+    //The root map's header is always a map32 while we hold it, so it can be patched in place
+    static constexpr std::size_t rootHeaderSize = 5;
+
+    buffer_type buffer{ 0xdf, 0, 0, 0, 0 };
+    std::vector<WriteFrame> writeFrames{ WriteFrame{ 0, rootHeaderSize, 0 } };
+    ReadFrame rootRead{ rootHeaderSize, 0, rootHeaderSize, 0 };
+    std::vector<ReadFrame> readFrames;
+
+public:
+    MsgPackSerializer() = default;
+
+    //Creates a serializer holding a copy of a MessagePack document whose root is a map
+    static serializer_type Parse(std::string_view bytes)
+    {
+        serializer_type serializer;
+        serializer.buffer.assign(bytes.begin(), bytes.end());
+
+        std::size_t begin = 0;
+        std::uint32_t count = serializer.ReadMapHeader(begin);
+        serializer.buffer.erase(serializer.buffer.begin(), serializer.buffer.begin() + begin);
+        serializer.buffer.insert(serializer.buffer.begin(), rootHeaderSize, 0);
+        serializer.writeFrames[0].count = count;
+        serializer.WriteMapHeader(0, count, rootHeaderSize);
+
+        return serializer;
+    }
+
+    static serializer_type Load(std::istream& stream)
+    {
+        std::string bytes(std::istreambuf_iterator<char>(stream), {});
+        return Parse(bytes);
+    }
+
+    static serializer_type LoadFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        if(!stream)
+            throw std::runtime_error("MsgPackSerializer: could not open " + path.string());
+
+        return Load(stream);
+    }
+
+public:
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T value)
+    {
+        WriteKey(name);
+        WriteNumber(value);
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T& value)
+    {
+        value = ReadNumber<T>(FindField(name));
+    }
+
+    template<class P, std::enable_if_t<is_arithmetic_pointer_v<P>, bool> = true>
+    void Serialize(std::string_view name, const P value)
+    {
+        WriteKey(name);
+
+        if(value == nullptr)
+            buffer.push_back(0xc0);
+        else
+            WriteNumber(*value);
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, char>, bool> = true>
+    void Deserialize(std::string_view name, T*& value)
+    {
+        std::size_t offset = FindField(name);
+        value = (IsNil(offset)) ? nullptr : new T(ReadNumber<T>(offset));
+    }
+
+    //Contiguous arrays of numbers are MessagePack arrays, written and read in one pass
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Serialize(std::string_view name, const std::vector<T>& values)
+    {
+        SerializeArray(name, values.data(), values.size());
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Deserialize(std::string_view name, std::vector<T>& values)
+    {
+        std::size_t offset = FindField(name);
+        values.resize(ReadArrayHeader(offset));
+        ReadNumbers(offset, values.data(), values.size());
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const std::array<T, N>& values)
+    {
+        SerializeArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, std::array<T, N>& values)
+    {
+        DeserializeArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T (&values)[N])
+    {
+        SerializeArray(name, values, N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T (&values)[N])
+    {
+        DeserializeArray(name, values, N);
+    }
+
+    //Strings are values of their own rather than objects with fields
+    void Serialize(std::string_view name, std::string_view value)
+    {
+        WriteKey(name);
+        WriteString(value);
+    }
+
+    void Serialize(std::string_view name, const std::string& value)
+    {
+        Serialize(name, std::string_view(value));
+    }
+
+    void Serialize(std::string_view name, const char* value)
+    {
+        Serialize(name, CStringView(name, value));
+    }
+
+    void Deserialize(std::string_view name, std::string& value)
+    {
+        std::size_t offset = FindField(name);
+        value = ReadString(offset);
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T& value)
+    {
+        WriteKey(name);
+        OpenMap(serialize_field_count_v<T, serializer_type>);
+
+        SerializeConstruct<T, serializer_type>::Serialize(*this, value);
+
+        CloseMap();
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T& value)
+    {
+        PushReadFrame(FindField(name));
+
+        SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+
+        readFrames.pop_back();
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T* value)
+    {
+        if(value == nullptr)
+        {
+            WriteKey(name);
+            buffer.push_back(0xc0);
+        }
+        else
+        {
+            Serialize(name, *value);
+        }
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T*& value)
+    {
+        std::size_t offset = FindField(name);
+
+        if(IsNil(offset))
+        {
+            value = nullptr;
+        }
+        else
+        {
+            PushReadFrame(offset);
+
+            value = new T();
+            SerializeConstruct<T, serializer_type>::Deserialize(*this, *value);
+
+            readFrames.pop_back();
+        }
+    }
+
+    //Sequences of objects or object pointers are MessagePack arrays of maps, null for the null pointers
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Container<T, Rest...>& values)
+    {
+        WriteKey(name);
+        WriteArrayHeader(values.size());
+
+        for(const T& value : values)
+        {
+            if constexpr(std::is_pointer_v<T>)
+            {
+                if(value == nullptr)
+                    buffer.push_back(0xc0);
+                else
+                    WriteElement(*value);
+            }
+            else
+            {
+                WriteElement(value);
+            }
+        }
+    }
+
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Container<T, Rest...>& values)
+    {
+        std::size_t offset = FindField(name);
+        std::size_t count = ReadArrayHeader(offset);
+        EmplaceElements(values, count, [&](T& value)
+        {
+            if constexpr(std::is_pointer_v<T>)
+            {
+                if(!IsNil(offset))
+                {
+                    value = new std::remove_pointer_t<T>();
+                    ReadElement(offset, *value);
+                }
+            }
+            else
+            {
+                ReadElement(offset, value);
+            }
+            offset = SkipValue(offset);
+        });
+    }
+
+    //Maps keyed by strings are MessagePack maps with a field per entry, any other map is an array of { "key", "value" } maps
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Map<Key, Value, Rest...>& values)
+    {
+        WriteKey(name);
+        if constexpr(std::is_same_v<Key, std::string>)
+        {
+            OpenMap(values.size());
+            for(const auto& [key, value] : values)
+                Serialize(key, value);
+            CloseMap();
+        }
+        else
+        {
+            WriteArrayHeader(values.size());
+            for(const auto& [key, value] : values)
+            {
+                OpenMap(2);
+                Serialize("key", key);
+                Serialize("value", value);
+                CloseMap();
+            }
+        }
+    }
+
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Map<Key, Value, Rest...>& values)
+    {
+        std::size_t offset = FindField(name);
+        values.clear();
+
+        if constexpr(std::is_same_v<Key, std::string>)
+        {
+            PushReadFrame(offset);
+            ReadFrame frame = readFrames.back();
+
+            //Every entry takes at least two bytes, so a count larger than that is corrupt and isn't reserved for
+            ReserveEntries(values, std::min<std::size_t>(frame.count, (buffer.size() - frame.begin) / 2));
+
+            //Entries are read in order, so every field is found straight away where the last one ended
+            std::size_t entry = frame.begin;
+            for(std::uint32_t i = 0; i < frame.count; i++)
+            {
+                std::string_view key = ReadString(entry);
+                entry = SkipValue(entry);
+                Deserialize(key, EmplaceEntry(values, std::string(key)));
+            }
+            readFrames.pop_back();
+        }
+        else
+        {
+            std::size_t count = ReadArrayHeader(offset);
+            ReserveEntries(values, count);
+            for(std::size_t i = 0; i < count; i++)
+            {
+                PushReadFrame(offset);
+                Key key{};
+                Deserialize("key", key);
+                Deserialize("value", EmplaceEntry(values, key));
+                readFrames.pop_back();
+                offset = SkipValue(offset);
+            }
+        }
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolySerialize(std::string_view name, const Derived* value)
+    {
+        WriteKey(name);
+
+        if(value == nullptr)
+        {
+            buffer.push_back(0xc0);
+        }
+        else
+        {
+            OpenMap(0);
+
+            PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Serialize(*this, value);
+
+            CloseMap();
+        }
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolyDeserialize(std::string_view name, Derived*& value)
+    {
+        std::size_t offset = FindField(name);
+
+        if(IsNil(offset))
+        {
+            value = nullptr;
+        }
+        else
+        {
+            PushReadFrame(offset);
+
+            PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Deserialize(*this, value);
+
+            readFrames.pop_back();
+        }
+    }
+
+    //The encoded document, with a map32 header on the root map
+    const buffer_type& Data() const
+    {
+        return buffer;
+    }
+
+    //Adds every top level field of other we don't already have
+    void Merge(const serializer_type& other)
+    {
+        std::unordered_set<std::string_view> names;
+        for(std::size_t offset = rootHeaderSize; offset < buffer.size();)
+        {
+            names.insert(ReadString(offset));
+            offset = SkipValue(offset);
+        }
+
+        //Other's buffer could be ourselves, copy out what we need before we start appending
+        buffer_type entries;
+        std::uint32_t count = 0;
+        for(std::size_t offset = rootHeaderSize; offset < other.buffer.size();)
+        {
+            std::size_t value = offset;
+            std::string_view key = other.ReadString(value);
+            std::size_t end = other.SkipValue(value);
+            if(names.count(key) == 0)
+            {
+                entries.insert(entries.end(), other.buffer.begin() + offset, other.buffer.begin() + end);
+                count++;
+            }
+            offset = end;
+        }
+
+        buffer.insert(buffer.end(), entries.begin(), entries.end());
+        writeFrames[0].count += count;
+        WriteMapHeader(0, writeFrames[0].count, rootHeaderSize);
+    }
+
+    //Returns the document with the smallest header that fits the root map
+    std::string Dump() const
+    {
+        std::uint32_t count = writeFrames[0].count;
+        std::size_t headerSize = MapHeaderSize(count);
+
+        std::string bytes(headerSize + buffer.size() - rootHeaderSize, '\0');
+        std::uint8_t header[rootHeaderSize];
+        EncodeMapHeader(header, count, headerSize);
+        std::memcpy(bytes.data(), header, headerSize);
+        std::memcpy(bytes.data() + headerSize, buffer.data() + rootHeaderSize, buffer.size() - rootHeaderSize);
+
+        return bytes;
+    }
+
+private:
+    template<class T>
+    void SerializeArray(std::string_view name, const T* values, std::size_t count)
+    {
+        WriteKey(name);
+        WriteArrayHeader(count);
+
+        //Every number takes at most 9 bytes, most of them far fewer
+        buffer.reserve(buffer.size() + count * (1 + sizeof(T)));
+        for(std::size_t i = 0; i < count; i++)
+            WriteNumber(values[i]);
+    }
+
+    //Arrays that can't be resized must find exactly as many values in the data
+    template<class T>
+    void DeserializeArray(std::string_view name, T* values, std::size_t count)
+    {
+        std::size_t offset = FindField(name);
+        std::size_t size = ReadArrayHeader(offset);
+        if(size != count)
+            throw std::runtime_error("MsgPackSerializer: array \"" + std::string(name) + "\" has " + std::to_string(size) + " values, expected " + std::to_string(count));
+
+        ReadNumbers(offset, values, count);
+    }
+
+    template<class T>
+    void ReadNumbers(std::size_t offset, T* values, std::size_t count) const
+    {
+        for(std::size_t i = 0; i < count; i++)
+        {
+            values[i] = ReadNumber<T>(offset);
+            offset = SkipValue(offset);
+        }
+    }
+
+    template<class T>
+    void WriteElement(const T& value)
+    {
+        OpenMap(serialize_field_count_v<T, serializer_type>);
+        SerializeConstruct<T, serializer_type>::Serialize(*this, value);
+        CloseMap();
+    }
+
+    template<class T>
+    void ReadElement(std::size_t offset, T& value)
+    {
+        PushReadFrame(offset);
+        SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+        readFrames.pop_back();
+    }
+
+    void WriteKey(std::string_view name)
+    {
+        WriteFrame& frame = writeFrames.back();
+        frame.count++;
+
+        if(writeFrames.size() == 1)
+            WriteMapHeader(0, frame.count, rootHeaderSize);
+
+        WriteString(name);
+    }
+
+    //fieldCount is only a guess for the header's size, 0 when unknown
+    void OpenMap(std::size_t fieldCount)
+    {
+        std::size_t headerSize = (fieldCount > 0) ? MapHeaderSize(fieldCount) : 5;
+        writeFrames.push_back(WriteFrame{ buffer.size(), headerSize, 0 });
+        buffer.resize(buffer.size() + headerSize);
+    }
+
+    //Writes the map's header now that we know its size, shifting its fields if the guess was wrong
+    void CloseMap()
+    {
+        WriteFrame frame = writeFrames.back();
+        writeFrames.pop_back();
+
+        std::size_t headerSize = MapHeaderSize(frame.count);
+        auto header = buffer.begin() + frame.headerOffset;
+        if(headerSize > frame.headerSize)
+            buffer.insert(header, headerSize - frame.headerSize, 0);
+        else if(headerSize < frame.headerSize)
+            buffer.erase(header, header + (frame.headerSize - headerSize));
+
+        WriteMapHeader(frame.headerOffset, frame.count, headerSize);
+    }
+
+    static std::size_t MapHeaderSize(std::size_t count)
+    {
+        return (count < 16) ? 1 : (count <= 0xffff) ? 3 : 5;
+    }
+
+    static void EncodeMapHeader(std::uint8_t* out, std::uint32_t count, std::size_t headerSize)
+    {
+        switch(headerSize)
+        {
+        case 1:
+            out[0] = static_cast<std::uint8_t>(0x80 | count);
+            break;
+        case 3:
+            out[0] = 0xde;
+            EncodeBigEndian(out + 1, static_cast<std::uint16_t>(count));
+            break;
+        default:
+            out[0] = 0xdf;
+            EncodeBigEndian(out + 1, count);
+            break;
+        }
+    }
+
+    void WriteMapHeader(std::size_t offset, std::uint32_t count, std::size_t headerSize)
+    {
+        EncodeMapHeader(buffer.data() + offset, count, headerSize);
+    }
+
+    template<class U>
+    static void EncodeBigEndian(std::uint8_t* out, U value)
+    {
+        for(std::size_t i = 0; i < sizeof(U); i++)
+            out[i] = static_cast<std::uint8_t>(value >> ((sizeof(U) - 1 - i) * 8));
+    }
+
+    template<class U>
+    void WriteBigEndian(std::uint8_t type, U value)
+    {
+        std::size_t offset = buffer.size();
+        buffer.resize(offset + 1 + sizeof(U));
+        buffer[offset] = type;
+        EncodeBigEndian(buffer.data() + offset + 1, value);
+    }
+
+    template<class T>
+    void WriteNumber(const T value)
+    {
+        static_assert(!std::is_same_v<T, long double>, "long double has no MessagePack representation");
+
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            buffer.push_back(value ? 0xc3 : 0xc2);
+        }
+        else if constexpr(std::is_floating_point_v<T>)
+        {
+            //Doubles which survive the round trip through a float lose nothing by being stored as one.
+            //Finite doubles outside of float's range can't be converted at all, so they're checked first
+            if(sizeof(T) == 4 || !std::isfinite(value) || (std::fabs(value) <= std::numeric_limits<float>::max() && static_cast<double>(static_cast<float>(value)) == value))
+            {
+                float f = static_cast<float>(value);
+                std::uint32_t bits;
+                std::memcpy(&bits, &f, sizeof(bits));
+                WriteBigEndian(0xca, bits);
+            }
+            else
+            {
+                double d = value;
+                std::uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(bits));
+                WriteBigEndian(0xcb, bits);
+            }
+        }
+        else if constexpr(std::is_signed_v<T>)
+        {
+            std::int64_t v = value;
+            if(v >= 0)
+                WriteUnsigned(static_cast<std::uint64_t>(v));
+            else if(v >= -32)
+                buffer.push_back(static_cast<std::uint8_t>(v));
+            else if(v >= std::numeric_limits<std::int8_t>::min())
+                WriteBigEndian(0xd0, static_cast<std::uint8_t>(v));
+            else if(v >= std::numeric_limits<std::int16_t>::min())
+                WriteBigEndian(0xd1, static_cast<std::uint16_t>(v));
+            else if(v >= std::numeric_limits<std::int32_t>::min())
+                WriteBigEndian(0xd2, static_cast<std::uint32_t>(v));
+            else
+                WriteBigEndian(0xd3, static_cast<std::uint64_t>(v));
+        }
+        else
+        {
+            WriteUnsigned(static_cast<std::uint64_t>(value));
+        }
+    }
+
+    void WriteUnsigned(std::uint64_t v)
+    {
+        if(v < 128)
+            buffer.push_back(static_cast<std::uint8_t>(v));
+        else if(v <= std::numeric_limits<std::uint8_t>::max())
+            WriteBigEndian(0xcc, static_cast<std::uint8_t>(v));
+        else if(v <= std::numeric_limits<std::uint16_t>::max())
+            WriteBigEndian(0xcd, static_cast<std::uint16_t>(v));
+        else if(v <= std::numeric_limits<std::uint32_t>::max())
+            WriteBigEndian(0xce, static_cast<std::uint32_t>(v));
+        else
+            WriteBigEndian(0xcf, v);
+    }
+
+    void WriteArrayHeader(std::size_t count)
+    {
+        if(count < 16)
+            buffer.push_back(static_cast<std::uint8_t>(0x90 | count));
+        else if(count <= std::numeric_limits<std::uint16_t>::max())
+            WriteBigEndian(0xdc, static_cast<std::uint16_t>(count));
+        else if(count <= std::numeric_limits<std::uint32_t>::max())
+            WriteBigEndian(0xdd, static_cast<std::uint32_t>(count));
+        else
+            throw std::length_error("MsgPackSerializer: array is too long");
+    }
+
+    void WriteString(std::string_view string)
+    {
+        std::size_t size = string.size();
+        if(size < 32)
+            buffer.push_back(static_cast<std::uint8_t>(0xa0 | size));
+        else if(size <= std::numeric_limits<std::uint8_t>::max())
+            WriteBigEndian(0xd9, static_cast<std::uint8_t>(size));
+        else if(size <= std::numeric_limits<std::uint16_t>::max())
+            WriteBigEndian(0xda, static_cast<std::uint16_t>(size));
+        else if(size <= std::numeric_limits<std::uint32_t>::max())
+            WriteBigEndian(0xdb, static_cast<std::uint32_t>(size));
+        else
+            throw std::length_error("MsgPackSerializer: string is too long");
+
+        buffer.insert(buffer.end(), string.begin(), string.end());
+    }
+
+    const std::uint8_t* At(std::size_t offset, std::size_t size) const
+    {
+        if(offset > buffer.size() || buffer.size() - offset < size)
+            throw std::out_of_range("MsgPackSerializer: read past the end of the data");
+
+        return buffer.data() + offset;
+    }
+
+    template<class U>
+    U ReadBigEndian(std::size_t offset) const
+    {
+        const std::uint8_t* in = At(offset, sizeof(U));
+
+        U value = 0;
+        for(std::size_t i = 0; i < sizeof(U); i++)
+            value = static_cast<U>((static_cast<std::uint64_t>(value) << 8) | in[i]);
+
+        return value;
+    }
+
+    bool IsNil(std::size_t offset) const
+    {
+        return *At(offset, 1) == 0xc0;
+    }
+
+    template<class T>
+    T ReadNumber(std::size_t offset) const
+    {
+        std::uint8_t type = *At(offset, 1);
+
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            if(type != 0xc2 && type != 0xc3)
+                throw std::runtime_error("MsgPackSerializer: expected a bool");
+
+            return type == 0xc3;
+        }
+        else
+        {
+            if(type == 0xca || type == 0xcb)
+            {
+                if constexpr(!std::is_floating_point_v<T>)
+                {
+                    throw std::runtime_error("MsgPackSerializer: expected an integer");
+                }
+                else if(type == 0xca)
+                {
+                    std::uint32_t bits = ReadBigEndian<std::uint32_t>(offset + 1);
+                    float f;
+                    std::memcpy(&f, &bits, sizeof(f));
+                    return static_cast<T>(f);
+                }
+                else
+                {
+                    std::uint64_t bits = ReadBigEndian<std::uint64_t>(offset + 1);
+                    double d;
+                    std::memcpy(&d, &bits, sizeof(d));
+                    return static_cast<T>(d);
+                }
+            }
+
+            if(type <= 0x7f)
+                return Narrow<T>(static_cast<std::uint64_t>(type));
+            if(type >= 0xe0)
+                return Narrow<T>(static_cast<std::int64_t>(static_cast<std::int8_t>(type)));
+
+            switch(type)
+            {
+            case 0xcc: return Narrow<T>(static_cast<std::uint64_t>(ReadBigEndian<std::uint8_t>(offset + 1)));
+            case 0xcd: return Narrow<T>(static_cast<std::uint64_t>(ReadBigEndian<std::uint16_t>(offset + 1)));
+            case 0xce: return Narrow<T>(static_cast<std::uint64_t>(ReadBigEndian<std::uint32_t>(offset + 1)));
+            case 0xcf: return Narrow<T>(ReadBigEndian<std::uint64_t>(offset + 1));
+            case 0xd0: return Narrow<T>(static_cast<std::int64_t>(static_cast<std::int8_t>(ReadBigEndian<std::uint8_t>(offset + 1))));
+            case 0xd1: return Narrow<T>(static_cast<std::int64_t>(static_cast<std::int16_t>(ReadBigEndian<std::uint16_t>(offset + 1))));
+            case 0xd2: return Narrow<T>(static_cast<std::int64_t>(static_cast<std::int32_t>(ReadBigEndian<std::uint32_t>(offset + 1))));
+            case 0xd3: return Narrow<T>(static_cast<std::int64_t>(ReadBigEndian<std::uint64_t>(offset + 1)));
+            default:
+                throw std::runtime_error("MsgPackSerializer: expected a number");
+            }
+        }
+    }
+
+    //Integers were written in however few bytes they fit in, so check they fit in what they're read into
+    template<class T, class V>
+    static T Narrow(V value)
+    {
+        if constexpr(std::is_integral_v<T>)
+        {
+            bool fits;
+            if constexpr(std::is_signed_v<V>)
+                fits = (value < 0) ? (std::is_signed_v<T> && value >= static_cast<std::int64_t>(std::numeric_limits<T>::min())) :
+                                     static_cast<std::uint64_t>(value) <= static_cast<std::uint64_t>(std::numeric_limits<T>::max());
+            else
+                fits = value <= static_cast<std::uint64_t>(std::numeric_limits<T>::max());
+
+            if(!fits)
+                throw std::out_of_range("MsgPackSerializer: integer doesn't fit in the type it's read into");
+        }
+
+        return static_cast<T>(value);
+    }
+
+    //Returns the string at offset and moves offset past it
+    std::string_view ReadString(std::size_t& offset) const
+    {
+        std::uint8_t type = *At(offset, 1);
+        std::size_t size;
+        std::size_t headerSize;
+
+        if((type & 0xe0) == 0xa0)
+        {
+            size = type & 0x1f;
+            headerSize = 1;
+        }
+        else if(type == 0xd9)
+        {
+            size = ReadBigEndian<std::uint8_t>(offset + 1);
+            headerSize = 2;
+        }
+        else if(type == 0xda)
+        {
+            size = ReadBigEndian<std::uint16_t>(offset + 1);
+            headerSize = 3;
+        }
+        else if(type == 0xdb)
+        {
+            size = ReadBigEndian<std::uint32_t>(offset + 1);
+            headerSize = 5;
+        }
+        else
+        {
+            throw std::runtime_error("MsgPackSerializer: expected a string");
+        }
+
+        const char* data = reinterpret_cast<const char*>(At(offset + headerSize, size));
+        offset += headerSize + size;
+        return std::string_view(data, size);
+    }
+
+    //Returns the number of entries in the map at offset and moves offset to its first entry
+    std::uint32_t ReadMapHeader(std::size_t& offset) const
+    {
+        std::uint8_t type = *At(offset, 1);
+
+        if((type & 0xf0) == 0x80)
+        {
+            offset += 1;
+            return type & 0x0f;
+        }
+        if(type == 0xde)
+        {
+            std::uint32_t count = ReadBigEndian<std::uint16_t>(offset + 1);
+            offset += 3;
+            return count;
+        }
+        if(type == 0xdf)
+        {
+            std::uint32_t count = ReadBigEndian<std::uint32_t>(offset + 1);
+            offset += 5;
+            return count;
+        }
+
+        throw std::runtime_error("MsgPackSerializer: expected an object");
+    }
+
+    //Returns the number of values in the array at offset and moves offset to its first value
+    std::uint32_t ReadArrayHeader(std::size_t& offset) const
+    {
+        std::uint8_t type = *At(offset, 1);
+        std::uint32_t count;
+
+        if((type & 0xf0) == 0x90)
+        {
+            count = type & 0x0f;
+            offset += 1;
+        }
+        else if(type == 0xdc)
+        {
+            count = ReadBigEndian<std::uint16_t>(offset + 1);
+            offset += 3;
+        }
+        else if(type == 0xdd)
+        {
+            count = ReadBigEndian<std::uint32_t>(offset + 1);
+            offset += 5;
+        }
+        else
+        {
+            throw std::runtime_error("MsgPackSerializer: expected an array");
+        }
+
+        //Every value takes at least a byte, so a count larger than what's left is corrupt
+        if(count > buffer.size() - offset)
+            throw std::out_of_range("MsgPackSerializer: read past the end of the data");
+
+        return count;
+    }
+
+    //Returns the offset just past the value at offset.
+    //Iterative, containers only add their entries to the count of values left to skip, so nesting depth can't overflow the stack
+    std::size_t SkipValue(std::size_t offset) const
+    {
+        for(std::uint64_t pending = 1; pending > 0; pending--)
+            offset = SkipHeader(offset, pending);
+
+        return offset;
+    }
+
+    //Returns the offset just past the scalar at offset, or just past the header of the container at offset
+    //in which case its entries are added to pending
+    std::size_t SkipHeader(std::size_t offset, std::uint64_t& pending) const
+    {
+        std::uint8_t type = *At(offset, 1);
+
+        if(type <= 0x7f || type >= 0xe0 || type == 0xc0 || type == 0xc2 || type == 0xc3)
+            return offset + 1;
+        if((type & 0xe0) == 0xa0 || type == 0xd9 || type == 0xda || type == 0xdb)
+        {
+            ReadString(offset);
+            return offset;
+        }
+        if((type & 0xf0) == 0x80 || type == 0xde || type == 0xdf)
+        {
+            pending += ReadMapHeader(offset) * std::uint64_t(2);
+            return offset;
+        }
+        if((type & 0xf0) == 0x90 || type == 0xdc || type == 0xdd)
+        {
+            pending += ReadArrayHeader(offset);
+            return offset;
+        }
+
+        switch(type)
+        {
+        case 0xcc: case 0xd0: case 0xd4: return offset + 2;
+        case 0xcd: case 0xd1: case 0xd5: return offset + 3;
+        case 0xd6: return offset + 6;
+        case 0xca: case 0xce: case 0xd2: return offset + 5;
+        case 0xcb: case 0xcf: case 0xd3: return offset + 9;
+        case 0xd7: return offset + 10;
+        case 0xd8: return offset + 18;
+        case 0xc4: return offset + 2 + ReadBigEndian<std::uint8_t>(offset + 1);
+        case 0xc5: return offset + 3 + ReadBigEndian<std::uint16_t>(offset + 1);
+        case 0xc6: return offset + 5 + ReadBigEndian<std::uint32_t>(offset + 1);
+        case 0xc7: return offset + 3 + ReadBigEndian<std::uint8_t>(offset + 1);
+        case 0xc8: return offset + 4 + ReadBigEndian<std::uint16_t>(offset + 1);
+        case 0xc9: return offset + 6 + ReadBigEndian<std::uint32_t>(offset + 1);
+        default:
+            throw std::runtime_error("MsgPackSerializer: invalid type byte");
+        }
+    }
+
+    void PushReadFrame(std::size_t offset)
+    {
+        std::uint32_t count = ReadMapHeader(offset);
+        readFrames.push_back(ReadFrame{ offset, count, offset, 0 });
+    }
+
+    //Returns the offset of the value of the field called name in the map currently being read
+    std::size_t FindField(std::string_view name)
+    {
+        ReadFrame& frame = (readFrames.empty()) ? rootRead : readFrames.back();
+        if(readFrames.empty())
+            frame.count = writeFrames[0].count;
+
+        std::size_t offset = frame.next;
+        std::uint32_t index = frame.nextIndex;
+        for(std::uint32_t searched = 0; searched < frame.count; searched++)
+        {
+            if(index >= frame.count)
+            {
+                index = 0;
+                offset = frame.begin;
+            }
+
+            std::string_view key = ReadString(offset);
+            std::size_t value = offset;
+            offset = SkipValue(offset);
+            index++;
+
+            if(key == name)
+            {
+                frame.next = offset;
+                frame.nextIndex = index;
+                return value;
+            }
+        }
+
+        throw std::out_of_range("MsgPackSerializer: missing field \"" + std::string(name) + "\"");
+    }
+};
@@ -0,0 +1,234 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include "Crc32c.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+//Every record is framed by a 16 byte header: a 4 byte sync marker, the payload's length (u32), the payload's CRC32C,
+//then a CRC32C of the 12 bytes before it. Checking the header on its own means a corrupt length is never trusted,
+//and the marker is what a reader searches for to find the next frame after damage
+struct RecordFrame
+{
+    static constexpr std::size_t headerSize = 16;
+    static constexpr char marker[4] = { '\xC3', '\x5A', '\x9E', '\x71' };
+
+    static void StoreUnsigned(char* out, std::uint32_t value)
+    {
+        for(std::size_t i = 0; i < 4; i++)
+            out[i] = static_cast<char>(value >> (i * 8));
+    }
+
+    static std::uint32_t LoadUnsigned(const char* bytes)
+    {
+        std::uint32_t value = 0;
+        for(std::size_t i = 0; i < 4; i++)
+            value |= std::uint32_t(static_cast<std::uint8_t>(bytes[i])) << (i * 8);
+        return value;
+    }
+};
+
+//Appends framed records to a stream, such as a file opened with std::ios::app. A crash part way through a record
+//leaves a torn frame at the end, which readers skip
+class RecordWriter
+{
+private:
+    std::ostream& stream;
+
+public:
+    explicit RecordWriter(std::ostream& stream) :
+        stream(stream)
+    {
+    }
+
+    //Frames whatever the serializer dumps
+    template<class SerializerT>
+    void Append(const SerializerT& serializer)
+    {
+        AppendBytes(serializer.Dump());
+    }
+
+    void AppendBytes(std::string_view payload)
+    {
+        char header[RecordFrame::headerSize];
+        WriteHeader(payload, header);
+
+        stream.write(header, sizeof(header));
+        stream.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if(!stream)
+            throw std::runtime_error("RecordWriter: could not write a record");
+    }
+
+    //Makes sure everything appended so far has reached the file
+    void Flush()
+    {
+        stream.flush();
+        if(!stream)
+            throw std::runtime_error("RecordWriter: could not flush");
+    }
+
+    //One framed record as bytes, for building a log in memory
+    static std::string Frame(std::string_view payload)
+    {
+        std::string frame(RecordFrame::headerSize, '\0');
+        WriteHeader(payload, frame.data());
+        frame.append(payload);
+        return frame;
+    }
+
+private:
+    static void WriteHeader(std::string_view payload, char* header)
+    {
+        if(payload.size() > UINT32_MAX)
+            throw std::length_error("RecordWriter: records are limited to 4GB");
+
+        std::memcpy(header, RecordFrame::marker, sizeof(RecordFrame::marker));
+        RecordFrame::StoreUnsigned(header + 4, static_cast<std::uint32_t>(payload.size()));
+        RecordFrame::StoreUnsigned(header + 8, Crc32c::Compute(payload.data(), payload.size()));
+        RecordFrame::StoreUnsigned(header + 12, Crc32c::Compute(header, 12));
+    }
+};
+
+//Reads framed records out of bytes in place, such as a MappedFile's View(). The bytes must outlive the reader.
+//Damaged frames and anything between frames are skipped by searching for the next sync marker, which also lets
+//reading start at any offset, like the middle of a file split across workers
+class RecordReader
+{
+private:
+    std::string_view bytes;
+    std::size_t position = 0;
+    std::size_t skippedBytes = 0;
+    std::size_t corruptFrames = 0;
+
+public:
+    explicit RecordReader(std::string_view bytes, std::size_t offset = 0) :
+        bytes(bytes)
+    {
+        Seek(offset);
+    }
+
+    //Gives the next intact record's payload. Returns false once there are none left
+    bool Next(std::string_view& payload)
+    {
+        while(bytes.size() - position >= RecordFrame::headerSize)
+        {
+            const char* header = bytes.data() + position;
+            if(std::memcmp(header, RecordFrame::marker, sizeof(RecordFrame::marker)) != 0)
+            {
+                Resync(position + 1);
+                continue;
+            }
+
+            std::uint32_t length = RecordFrame::LoadUnsigned(header + 4);
+            bool intact = RecordFrame::LoadUnsigned(header + 12) == Crc32c::Compute(header, 12) &&
+                          length <= bytes.size() - position - RecordFrame::headerSize &&
+                          RecordFrame::LoadUnsigned(header + 8) == Crc32c::Compute(header + RecordFrame::headerSize, length);
+
+            //A torn write followed by more appends leaves good frames inside a bad frame's claimed length, so the
+            //search restarts just past the bad marker instead of jumping over the length
+            if(!intact)
+            {
+                corruptFrames++;
+                Resync(position + 1);
+                continue;
+            }
+
+            payload = bytes.substr(position + RecordFrame::headerSize, length);
+            position += RecordFrame::headerSize + length;
+            return true;
+        }
+
+        skippedBytes += bytes.size() - position;
+        position = bytes.size();
+        return false;
+    }
+
+    //Parses the next intact record with SerializerT::Parse, passing it parseArgs after the payload
+    template<class SerializerT, class... Args>
+    bool Next(SerializerT& serializer, Args&&... parseArgs)
+    {
+        std::string_view payload;
+        if(!Next(payload))
+            return false;
+
+        serializer = SerializerT::Parse(payload, std::forward<Args>(parseArgs)...);
+        return true;
+    }
+
+    //Continues from offset, which doesn't need to be the start of a frame
+    void Seek(std::size_t offset)
+    {
+        position = (offset < bytes.size()) ? offset : bytes.size();
+    }
+
+    std::size_t Position() const
+    {
+        return position;
+    }
+
+    //Bytes passed over without being part of an intact frame
+    std::size_t SkippedBytes() const
+    {
+        return skippedBytes;
+    }
+
+    //Frames which had a marker but failed their header or payload checksum, or ran past the end
+    std::size_t CorruptFrames() const
+    {
+        return corruptFrames;
+    }
+
+private:
+    //Moves to the next marker at or after from, using memchr on the marker's first byte
+    void Resync(std::size_t from)
+    {
+        std::size_t next = bytes.size();
+        while(from < bytes.size())
+        {
+            const void* found = std::memchr(bytes.data() + from, RecordFrame::marker[0], bytes.size() - from);
+            if(found == nullptr)
+                break;
+
+            std::size_t candidate = static_cast<const char*>(found) - bytes.data();
+            if(bytes.size() - candidate < sizeof(RecordFrame::marker))
+                break;
+            if(std::memcmp(bytes.data() + candidate, RecordFrame::marker, sizeof(RecordFrame::marker)) == 0)
+            {
+                next = candidate;
+                break;
+            }
+            from = candidate + 1;
+        }
+
+        skippedBytes += next - position;
+        position = next;
+    }
+};
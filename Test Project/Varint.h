@@ -0,0 +1,232 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VARINT_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//LEB128 variable length integers, 7 bits per byte with the high bit set on every byte but the last.
+//Signed values are zigzagged first so small negative numbers stay small
+class Varint
+{
+public:
+    //The most bytes a T can take
+    template<class T>
+    static constexpr std::size_t maxSize = (sizeof(T) * 8 + 6) / 7;
+
+    template<class T>
+    static std::make_unsigned_t<T> ZigZag(T value)
+    {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<U>((static_cast<U>(value) << 1) ^ static_cast<U>(value < 0 ? ~U(0) : U(0)));
+    }
+
+    template<class T>
+    static T UnZigZag(std::make_unsigned_t<T> value)
+    {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<T>(static_cast<U>(value >> 1) ^ static_cast<U>(U(0) - (value & 1)));
+    }
+
+    //Writes value to out, which must have room for maxSize<T> bytes, and returns how many bytes it took
+    template<class T>
+    static std::size_t Encode(T value, std::uint8_t* out)
+    {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Varint: only integers have a varint encoding");
+
+        std::make_unsigned_t<T> bits = ToUnsigned(value);
+        std::size_t size = 0;
+        while(bits >= 0x80)
+        {
+            out[size++] = static_cast<std::uint8_t>(bits | 0x80);
+            bits >>= 7;
+        }
+        out[size++] = static_cast<std::uint8_t>(bits);
+
+        return size;
+    }
+
+    //Reads one value from [in, end) and returns how many bytes it took
+    template<class T>
+    static std::size_t Decode(const std::uint8_t* in, const std::uint8_t* end, T& value)
+    {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Varint: only integers have a varint encoding");
+
+        using U = std::make_unsigned_t<T>;
+        constexpr unsigned bits = sizeof(T) * 8;
+
+        U result = 0;
+        for(std::size_t i = 0; i < maxSize<T>; i++)
+        {
+            if(in + i == end)
+                throw std::out_of_range("Varint: read past the end of the data");
+
+            unsigned shift = static_cast<unsigned>(i * 7);
+            U payload = in[i] & 0x7f;
+            if(bits - shift < 7 && (payload >> (bits - shift)) != 0)
+                throw std::runtime_error("Varint: value doesn't fit in the type it's read into");
+
+            result |= static_cast<U>(payload << shift);
+            if((in[i] & 0x80) == 0)
+            {
+                value = FromUnsigned<T>(result);
+                return i + 1;
+            }
+        }
+
+        throw std::runtime_error("Varint: value doesn't fit in the type it's read into");
+    }
+
+    //Reads count values from [in, end) into out and returns how many bytes they took.
+    //Looks at 16 bytes at a time, runs of single byte values, which is what small ids and counters mostly are,
+    //are widened all at once and only the values which need more than a byte are decoded one by one
+    template<class T>
+    static std::size_t DecodeBulk(const std::uint8_t* in, const std::uint8_t* end, T* out, std::size_t count)
+    {
+        const std::uint8_t* position = in;
+        std::size_t i = 0;
+        while(i < count)
+        {
+#ifdef VARINT_SSE2
+            if(count - i >= 16 && end - position >= 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+                unsigned continuations = static_cast<unsigned>(_mm_movemask_epi8(bytes));
+                if(continuations == 0)
+                {
+                    Widen16(bytes, out + i);
+                    i += 16;
+                    position += 16;
+                    continue;
+                }
+
+                //Everything before the first continuation byte is a whole value
+                unsigned singles = CountTrailingZeros(continuations);
+                for(unsigned k = 0; k < singles; k++)
+                    out[i + k] = FromUnsigned<T>(position[k]);
+                i += singles;
+                position += singles;
+
+                //Mostly multi byte data, checking every value's window would cost more than it saves
+                if(singles == 0)
+                {
+                    for(std::size_t stop = i + multiByteRun; i < stop; i++)
+                        position += Decode(position, end, out[i]);
+                    continue;
+                }
+            }
+#endif
+            position += Decode(position, end, out[i]);
+            i++;
+        }
+
+        return static_cast<std::size_t>(position - in);
+    }
+
+private:
+    //How many values are decoded one by one when a window starts with a multi byte value, before looking at 16 bytes again
+    static constexpr std::size_t multiByteRun = 8;
+
+    template<class T>
+    static std::make_unsigned_t<T> ToUnsigned(T value)
+    {
+        if constexpr(std::is_signed_v<T>)
+            return ZigZag(value);
+        else
+            return value;
+    }
+
+    template<class T>
+    static T FromUnsigned(std::make_unsigned_t<T> value)
+    {
+        if constexpr(std::is_signed_v<T>)
+            return UnZigZag<T>(value);
+        else
+            return value;
+    }
+
+#ifdef VARINT_SSE2
+    static unsigned CountTrailingZeros(unsigned mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    //Sixteen single byte values, each one zero extended and un-zigzagged if T is signed
+    template<class T>
+    static void Widen16(__m128i bytes, T* out)
+    {
+        const __m128i zero = _mm_setzero_si128();
+
+        if constexpr(sizeof(T) == 2 || sizeof(T) == 4)
+        {
+            __m128i halves[2] = { _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+            for(__m128i& half : halves)
+            {
+                if constexpr(std::is_signed_v<T>)
+                    half = _mm_xor_si128(_mm_srli_epi16(half, 1), _mm_sub_epi16(zero, _mm_and_si128(half, _mm_set1_epi16(1))));
+            }
+
+            if constexpr(sizeof(T) == 2)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), halves[0]);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), halves[1]);
+            }
+            else
+            {
+                //Sign extends un-zigzagged negatives from 16 to 32 bits
+                for(int h = 0; h < 2; h++)
+                {
+                    __m128i sign = (std::is_signed_v<T>) ? _mm_srai_epi16(halves[h], 15) : zero;
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + h * 8), _mm_unpacklo_epi16(halves[h], sign));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + h * 8 + 4), _mm_unpackhi_epi16(halves[h], sign));
+                }
+            }
+        }
+        else
+        {
+            alignas(16) std::uint8_t values[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(values), bytes);
+            for(int k = 0; k < 16; k++)
+                out[k] = FromUnsigned<T>(values[k]);
+        }
+    }
+#endif
+};
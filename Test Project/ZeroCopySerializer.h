@@ -0,0 +1,998 @@
+/*
+MIT License
+
+Copyright (c) 2021 Renzy Alarcon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#pragma once
+#include "../Single Include/Serializer.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+//Layout of a zero copy document, everything is little endian
+//
+//  Header  "ZCP1", uint32 offset of the root table
+//  Table   uint32 count, then count entries of { uint32 name hash, uint32 name, uint32 value } sorted by hash then name
+//  Name    uint32 length, then the characters
+//  Value   arithmetic values aligned to their size, strings are a uint32 length then the characters,
+//          arrays of numbers are a uint32 count then the values aligned to their size,
+//          arrays of objects are a uint32 count then a uint32 per object pointing back at its table,
+//          objects are the offset of their own table
+//
+//Entry names and values are stored as the distance back from where the entry's field sits, a value of 0 meaning null.
+//Everything an entry refers to is written before it, and no offset is absolute, so a document can be appended
+//to another one without fixing anything up
+class ZeroCopyDocument
+{
+public:
+    static constexpr char magic[4] = { 'Z', 'C', 'P', '1' };
+    static constexpr std::uint32_t headerSize = 8;
+    static constexpr std::uint32_t entrySize = 12;
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    static constexpr bool littleEndianHost = false;
+#else
+    static constexpr bool littleEndianHost = true;
+#endif
+
+private:
+    std::string_view bytes;
+
+public:
+    ZeroCopyDocument() = default;
+
+    explicit ZeroCopyDocument(std::string_view bytes) :
+        bytes(bytes)
+    {
+    }
+
+    std::string_view Bytes() const
+    {
+        return bytes;
+    }
+
+    //Returns the root table, or 0 if bytes isn't a finished document
+    std::uint32_t Root() const
+    {
+        if(bytes.size() < headerSize || std::memcmp(bytes.data(), magic, sizeof(magic)) != 0)
+            throw std::runtime_error("ZeroCopyDocument: not a zero copy document");
+
+        return Load<std::uint32_t>(4);
+    }
+
+    static std::uint32_t Hash(std::string_view name)
+    {
+        //FNV-1a
+        std::uint32_t hash = 2166136261u;
+        for(char c : name)
+            hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+
+        return hash;
+    }
+
+    //Returns the offset a relative field at offset points to, 0 for null
+    std::uint32_t Follow(std::uint32_t offset) const
+    {
+        std::uint32_t distance = Load<std::uint32_t>(offset);
+        if(distance > offset)
+            throw std::out_of_range("ZeroCopyDocument: offset points before the document");
+
+        return (distance == 0) ? 0 : offset - distance;
+    }
+
+    //Returns the offset of the value called name in table, which is 0 when it's null, or nothing if there's no such field
+    std::optional<std::uint32_t> Find(std::uint32_t table, std::string_view name) const
+    {
+        std::uint32_t count = Load<std::uint32_t>(table);
+        std::uint32_t entries = table + 4;
+        At(entries, std::size_t(count) * entrySize);
+
+        std::uint32_t hash = Hash(name);
+        std::uint32_t first = 0;
+        std::uint32_t last = count;
+        while(first < last)
+        {
+            std::uint32_t middle = first + (last - first) / 2;
+            if(Load<std::uint32_t>(entries + middle * entrySize) < hash)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+
+        for(std::uint32_t entry = entries + first * entrySize; first < count && Load<std::uint32_t>(entry) == hash; first++, entry += entrySize)
+        {
+            if(String(Follow(entry + 4)) == name)
+                return Follow(entry + 8);
+        }
+
+        return std::nullopt;
+    }
+
+    std::string_view String(std::uint32_t offset) const
+    {
+        std::uint32_t size = Load<std::uint32_t>(offset);
+        return std::string_view(At(offset + std::size_t(4), size), size);
+    }
+
+    //Returns the count of the array of Ts at offset, checking its values are all in the document
+    template<class T>
+    std::uint32_t ArraySize(std::uint32_t offset) const
+    {
+        std::uint32_t count = Load<std::uint32_t>(offset);
+        At(ArrayValues<T>(offset), std::size_t(count) * sizeof(T));
+        return count;
+    }
+
+    //Returns where the values of the array of Ts at offset start
+    template<class T>
+    static std::size_t ArrayValues(std::size_t offset)
+    {
+        return (offset + 4 + sizeof(T) - 1) / sizeof(T) * sizeof(T);
+    }
+
+    //Copies count little endian values at offset out all at once, unless they need swapping or checking one by one
+    template<class T>
+    void LoadArray(std::size_t offset, T* values, std::size_t count) const
+    {
+        const char* in = At(offset, count * sizeof(T));
+        if constexpr(littleEndianHost && !std::is_same_v<T, bool>)
+        {
+            if(count > 0)
+                std::memcpy(values, in, count * sizeof(T));
+        }
+        else
+        {
+            for(std::size_t i = 0; i < count; i++)
+                values[i] = Load<T>(offset + i * sizeof(T));
+        }
+    }
+
+    //Reads the little endian value at offset in place
+    template<class T>
+    T Load(std::size_t offset) const
+    {
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            return *At(offset, 1) != 0;
+        }
+        else
+        {
+            using Bits = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                         std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                         std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+            const std::uint8_t* in = reinterpret_cast<const std::uint8_t*>(At(offset, sizeof(T)));
+            Bits bits = 0;
+            for(std::size_t i = 0; i < sizeof(T); i++)
+                bits |= static_cast<Bits>(static_cast<Bits>(in[i]) << (i * 8));
+
+            T value;
+            std::memcpy(&value, &bits, sizeof(T));
+            return value;
+        }
+    }
+
+private:
+    const char* At(std::size_t offset, std::size_t size) const
+    {
+        if(offset > bytes.size() || bytes.size() - offset < size)
+            throw std::out_of_range("ZeroCopyDocument: read past the end of the document");
+
+        return bytes.data() + offset;
+    }
+};
+
+template<class T = void>
+class ZeroCopyView;
+
+//Serializer concept
+//Writes a document that can be read in place, see ZeroCopyDocument for the layout.
+//A serializer either writes a new document, which Dump() finishes, or reads an existing one made with Parse() or Reader().
+//Reading looks each field up by name in its object's table, so fields can be read in any order
+class ZeroCopySerializer
+{
+public:
+    using serializer_type = ZeroCopySerializer;
+    using buffer_type = std::vector<char>;
+
+private:
+    struct Entry
+    {
+        std::uint32_t hash;
+        std::uint32_t name;
+        std::uint32_t value;
+    };
+
+    buffer_type buffer{ 'Z', 'C', 'P', '1', 0, 0, 0, 0 };
+    std::map<std::string, std::uint32_t, std::less<>> names;
+
+    //Entries of the tables being written, the root is always the first one.
+    //Kept around at their deepest so nested objects reuse their capacity
+    std::vector<std::vector<Entry>> tables{ 1 };
+    std::size_t depth = 0;
+
+    //Set when reading, either our own buffer or bytes someone else owns
+    ZeroCopyDocument document;
+    std::vector<std::uint32_t> readTables;
+
+private:
+    template<class T>
+    friend class ZeroCopyView;
+
+public:
+    ZeroCopySerializer() = default;
+
+    ZeroCopySerializer(const ZeroCopySerializer& other) :
+        buffer(other.buffer),
+        names(other.names),
+        tables(other.tables),
+        depth(other.depth),
+        document((other.OwnsDocument()) ? ZeroCopyDocument(std::string_view(buffer.data(), buffer.size())) : other.document),
+        readTables(other.readTables)
+    {
+    }
+
+    ZeroCopySerializer(ZeroCopySerializer&&) = default;
+    ZeroCopySerializer& operator=(ZeroCopySerializer other)
+    {
+        buffer.swap(other.buffer);
+        names.swap(other.names);
+        tables.swap(other.tables);
+        std::swap(depth, other.depth);
+        std::swap(document, other.document);
+        readTables.swap(other.readTables);
+        return *this;
+    }
+
+    //Creates a serializer reading a copy of a dumped document
+    static serializer_type Parse(std::string_view bytes)
+    {
+        serializer_type serializer;
+        serializer.buffer.assign(bytes.begin(), bytes.end());
+        serializer.Open(std::string_view(serializer.buffer.data(), serializer.buffer.size()));
+        return serializer;
+    }
+
+    //Creates a serializer reading bytes in place, such as a MappedFile's View(). The bytes must outlive it
+    static serializer_type Reader(std::string_view bytes)
+    {
+        serializer_type serializer;
+        serializer.Open(bytes);
+        return serializer;
+    }
+
+    static serializer_type Load(std::istream& stream)
+    {
+        std::string bytes(std::istreambuf_iterator<char>(stream), {});
+        return Parse(bytes);
+    }
+
+    static serializer_type LoadFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        if(!stream)
+            throw std::runtime_error("ZeroCopySerializer: could not open " + path.string());
+
+        return Load(stream);
+    }
+
+public:
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T value)
+    {
+        AddEntry(name, WriteValue(value));
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T& value)
+    {
+        value = document.Load<T>(NotNull(name, FindField(name)));
+    }
+
+    template<class P, std::enable_if_t<is_arithmetic_pointer_v<P>, bool> = true>
+    void Serialize(std::string_view name, const P value)
+    {
+        AddEntry(name, (value == nullptr) ? 0 : WriteValue(*value));
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, char>, bool> = true>
+    void Deserialize(std::string_view name, T*& value)
+    {
+        std::uint32_t offset = FindField(name);
+        value = (offset == 0) ? nullptr : new T(document.Load<T>(offset));
+    }
+
+    //Contiguous arrays of numbers are laid out just like they are in memory, so they read back with one copy
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Serialize(std::string_view name, const std::vector<T>& values)
+    {
+        AddEntry(name, WriteArray(values.data(), values.size()));
+    }
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, bool> = true>
+    void Deserialize(std::string_view name, std::vector<T>& values)
+    {
+        std::uint32_t offset = NotNull(name, FindField(name));
+        values.resize(document.ArraySize<T>(offset));
+        document.LoadArray(ZeroCopyDocument::ArrayValues<T>(offset), values.data(), values.size());
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const std::array<T, N>& values)
+    {
+        AddEntry(name, WriteArray(values.data(), N));
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, std::array<T, N>& values)
+    {
+        DeserializeArray(name, values.data(), N);
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T (&values)[N])
+    {
+        AddEntry(name, WriteArray(values, N));
+    }
+
+    template<class T, std::size_t N, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T (&values)[N])
+    {
+        DeserializeArray(name, values, N);
+    }
+
+    //Strings are values of their own rather than objects with fields
+    void Serialize(std::string_view name, std::string_view value)
+    {
+        AddEntry(name, WriteString(value));
+    }
+
+    void Serialize(std::string_view name, const std::string& value)
+    {
+        Serialize(name, std::string_view(value));
+    }
+
+    void Serialize(std::string_view name, const char* value)
+    {
+        Serialize(name, CStringView(name, value));
+    }
+
+    void Deserialize(std::string_view name, std::string& value)
+    {
+        value = document.String(NotNull(name, FindField(name)));
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T& value)
+    {
+        PushTable(serialize_field_count_v<T, serializer_type>);
+
+        SerializeConstruct<T, serializer_type>::Serialize(*this, value);
+
+        AddEntry(name, PopTable());
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T& value)
+    {
+        readTables.push_back(NotNull(name, FindField(name)));
+
+        SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+
+        readTables.pop_back();
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Serialize(std::string_view name, const T* value)
+    {
+        if(value == nullptr)
+            AddEntry(name, 0);
+        else
+            Serialize(name, *value);
+    }
+
+    template<class T, std::enable_if_t<std::is_class_v<T>, bool> = true>
+    void Deserialize(std::string_view name, T*& value)
+    {
+        std::uint32_t offset = FindField(name);
+
+        if(offset == 0)
+        {
+            value = nullptr;
+        }
+        else
+        {
+            readTables.push_back(offset);
+
+            value = new T();
+            SerializeConstruct<T, serializer_type>::Deserialize(*this, *value);
+
+            readTables.pop_back();
+        }
+    }
+
+    //Sequences of objects or object pointers write every object's table, then an array pointing at them
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Container<T, Rest...>& values)
+    {
+        std::vector<std::uint32_t> elements;
+        elements.reserve(values.size());
+        for(const T& value : values)
+        {
+            if constexpr(std::is_pointer_v<T>)
+                elements.push_back((value == nullptr) ? 0 : WriteElement(*value));
+            else
+                elements.push_back(WriteElement(value));
+        }
+
+        AddEntry(name, WriteTableArray(elements));
+    }
+
+    template<template<class...> class Container, class T, class... Rest, std::enable_if_t<is_object_sequence_v<Container<T, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Container<T, Rest...>& values)
+    {
+        std::uint32_t offset = NotNull(name, FindField(name));
+        std::uint32_t element = offset + 4;
+        EmplaceElements(values, document.ArraySize<std::uint32_t>(offset), [&](T& value)
+        {
+            std::uint32_t table = document.Follow(element);
+            element += 4;
+
+            if constexpr(std::is_pointer_v<T>)
+            {
+                if(table == 0)
+                    return;
+
+                value = new std::remove_pointer_t<T>();
+                ReadElement(table, *value);
+            }
+            else
+            {
+                ReadElement(NotNull(name, table), value);
+            }
+        });
+    }
+
+    //Maps keyed by strings are tables with a field per entry, any other map is an array of { "key", "value" } tables
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Serialize(std::string_view name, const Map<Key, Value, Rest...>& values)
+    {
+        if constexpr(std::is_same_v<Key, std::string>)
+        {
+            PushTable(values.size());
+            for(const auto& [key, value] : values)
+                Serialize(key, value);
+            AddEntry(name, PopTable());
+        }
+        else
+        {
+            std::vector<std::uint32_t> entries;
+            entries.reserve(values.size());
+            for(const auto& [key, value] : values)
+            {
+                PushTable(2);
+                Serialize("key", key);
+                Serialize("value", value);
+                entries.push_back(PopTable());
+            }
+            AddEntry(name, WriteTableArray(entries));
+        }
+    }
+
+    template<template<class...> class Map, class Key, class Value, class... Rest, std::enable_if_t<is_serializable_map_v<Map<Key, Value, Rest...>>, bool> = true>
+    void Deserialize(std::string_view name, Map<Key, Value, Rest...>& values)
+    {
+        std::uint32_t offset = NotNull(name, FindField(name));
+        values.clear();
+
+        if constexpr(std::is_same_v<Key, std::string>)
+        {
+            //A count larger than the document could hold entries for is corrupt and isn't reserved for
+            std::uint32_t count = document.Load<std::uint32_t>(offset);
+            ReserveEntries(values, std::min<std::size_t>(count, document.Bytes().size() / ZeroCopyDocument::entrySize));
+
+            readTables.push_back(offset);
+            for(std::uint32_t i = 0, entry = offset + 4; i < count; i++, entry += ZeroCopyDocument::entrySize)
+            {
+                std::string_view key = document.String(document.Follow(entry + 4));
+                Deserialize(key, EmplaceEntry(values, std::string(key)));
+            }
+            readTables.pop_back();
+        }
+        else
+        {
+            std::uint32_t count = document.ArraySize<std::uint32_t>(offset);
+            ReserveEntries(values, count);
+            for(std::uint32_t i = 0, element = offset + 4; i < count; i++, element += 4)
+            {
+                readTables.push_back(NotNull(name, document.Follow(element)));
+                Key key{};
+                Deserialize("key", key);
+                Deserialize("value", EmplaceEntry(values, key));
+                readTables.pop_back();
+            }
+        }
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolySerialize(std::string_view name, const Derived* value)
+    {
+        if(value == nullptr)
+        {
+            AddEntry(name, 0);
+        }
+        else
+        {
+            PushTable(0);
+
+            PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Serialize(*this, value);
+
+            AddEntry(name, PopTable());
+        }
+    }
+
+    template<class Base, class Derived, std::enable_if_t<std::is_base_of_v<Base, Derived>, bool> = true>
+    void PolyDeserialize(std::string_view name, Derived*& value)
+    {
+        std::uint32_t offset = FindField(name);
+
+        if(offset == 0)
+        {
+            value = nullptr;
+        }
+        else
+        {
+            readTables.push_back(offset);
+
+            PolymorphicSerializeConstruct<Base, Derived, serializer_type>::Deserialize(*this, value);
+
+            readTables.pop_back();
+        }
+    }
+
+    //The values and nested tables written so far. Dump() adds the root table which makes them a document
+    const buffer_type& Data() const
+    {
+        return buffer;
+    }
+
+    //Adds every top level field of other we don't already have to the document we're writing.
+    //Other's bytes are appended as they are
+    void Merge(const serializer_type& other)
+    {
+        //Other could be ourselves, copy out what we need before we start appending
+        std::vector<Entry> otherRoot = other.RootEntries();
+        std::string otherBytes((other.IsReading()) ? other.document.Bytes() : std::string_view(other.buffer.data(), other.buffer.size()));
+
+        std::unordered_set<std::string_view> ours;
+        for(const Entry& entry : tables[0])
+            ours.insert(NameAt(std::string_view(buffer.data(), buffer.size()), entry.name));
+
+        std::vector<Entry> added;
+        for(const Entry& entry : otherRoot)
+        {
+            if(ours.count(NameAt(otherBytes, entry.name)) == 0)
+                added.push_back(entry);
+        }
+
+        //Other's offsets are all relative, so only the root entries need moving by where its bytes land
+        Align(buffer, 8);
+        std::uint32_t shift = static_cast<std::uint32_t>(buffer.size()) - ZeroCopyDocument::headerSize;
+        buffer.insert(buffer.end(), otherBytes.begin() + ZeroCopyDocument::headerSize, otherBytes.end());
+
+        for(Entry& entry : added)
+        {
+            entry.name += shift;
+            entry.value += (entry.value == 0) ? 0 : shift;
+            tables[0].push_back(entry);
+        }
+    }
+
+    //Returns the finished document, our bytes followed by the root table
+    std::string Dump() const
+    {
+        buffer_type bytes = buffer;
+        std::uint32_t root = WriteTable(bytes, tables[0]);
+        StoreLittleEndian(bytes, 4, root);
+
+        return std::string(bytes.begin(), bytes.end());
+    }
+
+    void Dump(std::ostream& stream) const
+    {
+        std::string bytes = Dump();
+        stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+private:
+    void Open(std::string_view bytes)
+    {
+        document = ZeroCopyDocument(bytes);
+        std::uint32_t root = document.Root();
+        if(root == 0)
+            throw std::runtime_error("ZeroCopySerializer: document was never finished with Dump()");
+
+        readTables.assign(1, root);
+    }
+
+    bool IsReading() const
+    {
+        return !readTables.empty();
+    }
+
+    bool OwnsDocument() const
+    {
+        return IsReading() && document.Bytes().data() == buffer.data();
+    }
+
+    std::vector<Entry> RootEntries() const
+    {
+        if(!IsReading())
+            return tables[0];
+
+        std::uint32_t root = readTables[0];
+        std::uint32_t count = document.Load<std::uint32_t>(root);
+
+        std::vector<Entry> entries;
+        entries.reserve(count);
+        for(std::uint32_t i = 0, entry = root + 4; i < count; i++, entry += ZeroCopyDocument::entrySize)
+            entries.push_back(Entry{ document.Load<std::uint32_t>(entry), document.Follow(entry + 4), document.Follow(entry + 8) });
+
+        return entries;
+    }
+
+    std::uint32_t FindField(std::string_view name) const
+    {
+        if(!IsReading())
+            throw std::logic_error("ZeroCopySerializer: nothing to read, Parse() or Reader() a dumped document first");
+
+        std::optional<std::uint32_t> offset = document.Find(readTables.back(), name);
+        if(!offset)
+            throw std::out_of_range("ZeroCopySerializer: missing field \"" + std::string(name) + "\"");
+
+        return *offset;
+    }
+
+    //Writes value's table and returns where it is
+    template<class T>
+    std::uint32_t WriteElement(const T& value)
+    {
+        PushTable(serialize_field_count_v<T, serializer_type>);
+        SerializeConstruct<T, serializer_type>::Serialize(*this, value);
+        return PopTable();
+    }
+
+    template<class T>
+    void ReadElement(std::uint32_t table, T& value)
+    {
+        readTables.push_back(table);
+        SerializeConstruct<T, serializer_type>::Deserialize(*this, value);
+        readTables.pop_back();
+    }
+
+    //Arrays that can't be resized must find exactly as many values in the document
+    template<class T>
+    void DeserializeArray(std::string_view name, T* values, std::size_t count) const
+    {
+        std::uint32_t offset = NotNull(name, FindField(name));
+        std::uint32_t size = document.ArraySize<T>(offset);
+        if(size != count)
+            throw std::runtime_error("ZeroCopySerializer: array \"" + std::string(name) + "\" has " + std::to_string(size) + " values, expected " + std::to_string(count));
+
+        document.LoadArray(ZeroCopyDocument::ArrayValues<T>(offset), values, count);
+    }
+
+    static std::uint32_t NotNull(std::string_view name, std::uint32_t offset)
+    {
+        if(offset == 0)
+            throw std::runtime_error("ZeroCopySerializer: field \"" + std::string(name) + "\" is null");
+
+        return offset;
+    }
+
+    void AddEntry(std::string_view name, std::uint32_t value)
+    {
+        tables[depth].push_back(Entry{ ZeroCopyDocument::Hash(name), WriteName(name), value });
+    }
+
+    void PushTable(std::size_t fieldCount)
+    {
+        depth++;
+        if(depth == tables.size())
+            tables.emplace_back();
+
+        tables[depth].clear();
+        tables[depth].reserve(fieldCount);
+    }
+
+    std::uint32_t PopTable()
+    {
+        std::uint32_t table = WriteTable(buffer, tables[depth]);
+        depth--;
+        return table;
+    }
+
+    //Names are pooled, every table using the same field name points at the same bytes
+    std::uint32_t WriteName(std::string_view name)
+    {
+        auto it = names.find(name);
+        if(it != names.end())
+            return it->second;
+
+        std::uint32_t offset = WriteString(name);
+        names.emplace(std::string(name), offset);
+        return offset;
+    }
+
+    std::uint32_t WriteString(std::string_view string)
+    {
+        Align(buffer, 4);
+        std::uint32_t offset = Offset(buffer);
+        StoreLittleEndian(buffer, offset, static_cast<std::uint32_t>(string.size()));
+        buffer.insert(buffer.end(), string.begin(), string.end());
+        return offset;
+    }
+
+    template<class T>
+    std::uint32_t WriteValue(const T value)
+    {
+        static_assert(!std::is_same_v<T, long double>, "long double has no fixed size representation");
+
+        Align(buffer, sizeof(T));
+        std::uint32_t offset = Offset(buffer);
+        if constexpr(std::is_same_v<T, bool>)
+        {
+            buffer.push_back(value ? 1 : 0);
+        }
+        else
+        {
+            using Bits = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                         std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                         std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+            Bits bits;
+            std::memcpy(&bits, &value, sizeof(T));
+            StoreLittleEndian(buffer, offset, bits);
+        }
+
+        return offset;
+    }
+
+    template<class T>
+    std::uint32_t WriteArray(const T* values, std::size_t count)
+    {
+        static_assert(!std::is_same_v<T, long double>, "long double has no fixed size representation");
+        if(count > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("ZeroCopySerializer: array is too long");
+
+        Align(buffer, 4);
+        std::uint32_t offset = Offset(buffer);
+        StoreLittleEndian(buffer, offset, static_cast<std::uint32_t>(count));
+        Align(buffer, sizeof(T));
+
+        if constexpr(ZeroCopyDocument::littleEndianHost && !std::is_same_v<T, bool>)
+        {
+            const char* bytes = reinterpret_cast<const char*>(values);
+            buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+        }
+        else
+        {
+            buffer.reserve(buffer.size() + count * sizeof(T));
+            for(std::size_t i = 0; i < count; i++)
+                WriteValue(values[i]);
+        }
+
+        return offset;
+    }
+
+    //Like a table's values, each element is stored as the distance back to what it points to
+    std::uint32_t WriteTableArray(const std::vector<std::uint32_t>& elements)
+    {
+        if(elements.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("ZeroCopySerializer: array is too long");
+
+        Align(buffer, 4);
+        std::uint32_t offset = Offset(buffer);
+        StoreLittleEndian(buffer, offset, static_cast<std::uint32_t>(elements.size()));
+        for(std::uint32_t element : elements)
+        {
+            std::uint32_t field = Offset(buffer);
+            StoreLittleEndian(buffer, field, (element == 0) ? 0 : field - element);
+        }
+
+        return offset;
+    }
+
+    //Sorts the entries so readers can binary search them, a name written twice keeps its last value
+    static std::uint32_t WriteTable(buffer_type& bytes, std::vector<Entry> entries)
+    {
+        std::string_view view(bytes.data(), bytes.size());
+        std::stable_sort(entries.begin(), entries.end(), [view](const Entry& a, const Entry& b)
+        {
+            return (a.hash != b.hash) ? a.hash < b.hash : NameAt(view, a.name) < NameAt(view, b.name);
+        });
+
+        std::size_t kept = 0;
+        for(std::size_t i = 0; i < entries.size(); i++)
+        {
+            bool overwritten = i + 1 < entries.size() && entries[i + 1].hash == entries[i].hash &&
+                               NameAt(view, entries[i + 1].name) == NameAt(view, entries[i].name);
+            if(!overwritten)
+                entries[kept++] = entries[i];
+        }
+        entries.resize(kept);
+
+        Align(bytes, 4);
+        std::uint32_t table = Offset(bytes);
+        StoreLittleEndian(bytes, table, static_cast<std::uint32_t>(entries.size()));
+        for(const Entry& entry : entries)
+        {
+            std::uint32_t field = Offset(bytes);
+            StoreLittleEndian(bytes, field, entry.hash);
+            StoreLittleEndian(bytes, field + 4, field + 4 - entry.name);
+            StoreLittleEndian(bytes, field + 8, (entry.value == 0) ? 0 : field + 8 - entry.value);
+        }
+
+        return table;
+    }
+
+    static std::string_view NameAt(std::string_view bytes, std::uint32_t offset)
+    {
+        return ZeroCopyDocument(bytes).String(offset);
+    }
+
+    static std::uint32_t Offset(const buffer_type& bytes)
+    {
+        if(bytes.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("ZeroCopySerializer: document is larger than 4 GiB");
+
+        return static_cast<std::uint32_t>(bytes.size());
+    }
+
+    static void Align(buffer_type& bytes, std::size_t alignment)
+    {
+        bytes.resize((bytes.size() + alignment - 1) / alignment * alignment);
+    }
+
+    //Writes value at offset, growing bytes if offset is its end
+    template<class U>
+    static void StoreLittleEndian(buffer_type& bytes, std::size_t offset, U value)
+    {
+        if(bytes.size() < offset + sizeof(U))
+            bytes.resize(offset + sizeof(U));
+
+        for(std::size_t i = 0; i < sizeof(U); i++)
+            bytes[offset + i] = static_cast<char>(value >> (i * 8));
+    }
+};
+
+//Reads fields of a T straight out of a document, without parsing it or copying them anywhere.
+//When an owned T is needed Deserialize() falls back to SerializeConstruct
+template<class T>
+class ZeroCopyView
+{
+public:
+    using value_type = T;
+
+private:
+    ZeroCopyDocument document;
+    std::uint32_t table = 0;
+
+private:
+    template<class U>
+    friend class ZeroCopyView;
+
+    ZeroCopyView(ZeroCopyDocument document, std::uint32_t table) :
+        document(document),
+        table(table)
+    {
+    }
+
+public:
+    //The root of a dumped document, such as a MappedFile's View(). The bytes must outlive the view
+    static ZeroCopyView Root(std::string_view bytes)
+    {
+        ZeroCopyDocument document(bytes);
+        std::uint32_t root = document.Root();
+        if(root == 0)
+            throw std::runtime_error("ZeroCopyView: document was never finished with Dump()");
+
+        return ZeroCopyView(document, root);
+    }
+
+    bool Has(std::string_view name) const
+    {
+        return document.Find(table, name).has_value();
+    }
+
+    bool IsNull(std::string_view name) const
+    {
+        return Find(name) == 0;
+    }
+
+    template<class U, std::enable_if_t<std::is_arithmetic_v<U>, bool> = true>
+    U Get(std::string_view name) const
+    {
+        return document.Load<U>(NotNull(name));
+    }
+
+    std::string_view GetString(std::string_view name) const
+    {
+        return document.String(NotNull(name));
+    }
+
+    template<class U>
+    ZeroCopyView<U> GetView(std::string_view name) const
+    {
+        return ZeroCopyView<U>(document, NotNull(name));
+    }
+
+    template<class U = T>
+    void Deserialize(U& value) const
+    {
+        static_assert(!std::is_void_v<U>, "ZeroCopyView: an untyped view has nothing to deserialize into");
+
+        ZeroCopySerializer serializer;
+        serializer.document = document;
+        serializer.readTables.assign(1, table);
+
+        SerializeConstruct<U, ZeroCopySerializer>::Deserialize(serializer, value);
+    }
+
+    template<class U = T>
+    U Deserialize() const
+    {
+        U value;
+        Deserialize(value);
+        return value;
+    }
+
+private:
+    std::uint32_t Find(std::string_view name) const
+    {
+        std::optional<std::uint32_t> offset = document.Find(table, name);
+        if(!offset)
+            throw std::out_of_range("ZeroCopyView: missing field \"" + std::string(name) + "\"");
+
+        return *offset;
+    }
+
+    std::uint32_t NotNull(std::string_view name) const
+    {
+        std::uint32_t offset = Find(name);
+        if(offset == 0)
+            throw std::runtime_error("ZeroCopyView: field \"" + std::string(name) + "\" is null");
+
+        return offset;
+    }
+};
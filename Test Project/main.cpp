@@ -23,12 +23,237 @@ SOFTWARE.
 
 */
 #include "JsonSerializer.h"
+#include "BinarySerializer.h"
+#include "MsgPackSerializer.h"
+#include "CborSerializer.h"
+#include "ZeroCopySerializer.h"
+#include "ColumnarSerializer.h"
+#include "MappedFile.h"
+#include "BlockCompressor.h"
+#include "RecordStream.h"
 #include "Foo.h"
 #include "Bar.h"
 #include <assert.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <list>
+#include <map>
+#include <unordered_map>
 #include <vector>
+#include <thread>
+#include <sstream>
 
 
+static_assert(serialize_field_count_v<Foo, JsonSerializer> == 1);
+static_assert(serialize_field_count_v<Bar, JsonSerializer> == 2);
+
+//Two versions of the same type, to check schema records can be read by a reader laid out differently
+struct PointV1
+{
+    int x;
+    int y;
+    std::string name;
+};
+
+struct PointV2
+{
+    std::string name;
+    std::int64_t y;
+    int z = 7;
+};
+
+template<class SerializerT>
+struct SerializeConstruct<PointV1, SerializerT>
+{
+    static void Serialize(SerializerT& serializer, const PointV1& v)
+    {
+        serializer.Serialize("x", v.x);
+        serializer.Serialize("y", v.y);
+        serializer.Serialize("name", v.name);
+    }
+
+    static void Deserialize(SerializerT& serializer, PointV1& v)
+    {
+        serializer.Deserialize("x", v.x);
+        serializer.Deserialize("y", v.y);
+        serializer.Deserialize("name", v.name);
+    }
+};
+
+//No padding and no floats, so it can opt into being copied as a whole
+struct Pixel
+{
+    std::int32_t x;
+    std::int32_t y;
+    std::uint16_t r;
+    std::uint16_t g;
+    std::uint16_t b;
+    std::uint16_t a;
+};
+
+//Same layout, written field by field
+struct SlowPixel : Pixel
+{
+};
+
+template<class SerializerT>
+struct SerializeConstruct<Pixel, SerializerT>
+{
+    static constexpr bool trivially_serializable = true;
+
+    static void Serialize(SerializerT& serializer, const Pixel& v)
+    {
+        serializer.Serialize("x", v.x);
+        serializer.Serialize("y", v.y);
+        serializer.Serialize("r", v.r);
+        serializer.Serialize("g", v.g);
+        serializer.Serialize("b", v.b);
+        serializer.Serialize("a", v.a);
+    }
+
+    static void Deserialize(SerializerT& serializer, Pixel& v)
+    {
+        serializer.Deserialize("x", v.x);
+        serializer.Deserialize("y", v.y);
+        serializer.Deserialize("r", v.r);
+        serializer.Deserialize("g", v.g);
+        serializer.Deserialize("b", v.b);
+        serializer.Deserialize("a", v.a);
+    }
+};
+
+template<class SerializerT>
+struct SerializeConstruct<SlowPixel, SerializerT>
+{
+    static void Serialize(SerializerT& serializer, const SlowPixel& v)
+    {
+        SerializeConstruct<Pixel, SerializerT>::Serialize(serializer, v);
+    }
+
+    static void Deserialize(SerializerT& serializer, SlowPixel& v)
+    {
+        SerializeConstruct<Pixel, SerializerT>::Deserialize(serializer, v);
+    }
+};
+
+static_assert(is_trivially_serializable_v<Pixel, BinarySerializer> && !is_trivially_serializable_v<SlowPixel, BinarySerializer>);
+
+template<class SerializerT>
+struct SerializeConstruct<PointV2, SerializerT>
+{
+    static void Serialize(SerializerT& serializer, const PointV2& v)
+    {
+        serializer.Serialize("name", v.name);
+        serializer.Serialize("y", v.y);
+        serializer.Serialize("z", v.z);
+    }
+
+    static void Deserialize(SerializerT& serializer, PointV2& v)
+    {
+        serializer.Deserialize("name", v.name);
+        serializer.Deserialize("y", v.y);
+        serializer.Deserialize("z", v.z);
+    }
+};
+
+//Arrays of numbers in every kind of container the serializers take in bulk
+struct Samples
+{
+    std::vector<int> ids;
+    std::array<double, 3> weights{};
+    std::uint16_t ports[2]{};
+    std::vector<std::int64_t> deltas;
+};
+
+template<class SerializerT>
+struct SerializeConstruct<Samples, SerializerT>
+{
+    static void Serialize(SerializerT& serializer, const Samples& v)
+    {
+        serializer.Serialize("ids", v.ids);
+        serializer.Serialize("weights", v.weights);
+        serializer.Serialize("ports", v.ports);
+        serializer.Serialize("deltas", v.deltas);
+    }
+
+    static void Deserialize(SerializerT& serializer, Samples& v)
+    {
+        serializer.Deserialize("ids", v.ids);
+        serializer.Deserialize("weights", v.weights);
+        serializer.Deserialize("ports", v.ports);
+        serializer.Deserialize("deltas", v.deltas);
+    }
+};
+
+//Samples read back by a reader that only wants the ids, and wider ones at that
+struct WideSamples
+{
+    std::vector<std::int64_t> ids;
+    int extra = 9;
+};
+
+template<class SerializerT>
+struct SerializeConstruct<WideSamples, SerializerT>
+{
+    static void Serialize(SerializerT& serializer, const WideSamples& v)
+    {
+        serializer.Serialize("ids", v.ids);
+        serializer.Serialize("extra", v.extra);
+    }
+
+    static void Deserialize(SerializerT& serializer, WideSamples& v)
+    {
+        serializer.Deserialize("ids", v.ids);
+        serializer.Deserialize("extra", v.extra);
+    }
+};
+
+static bool operator==(const Samples& a, const Samples& b)
+{
+    return a.ids == b.ids && a.weights == b.weights && a.ports[0] == b.ports[0] && a.ports[1] == b.ports[1] && a.deltas == b.deltas;
+}
+
+//Runs roundTrip(writer, reopen) with every serializer, the binary one in every mode with every integer encoding.
+//reopen returns a serializer reading back what writer wrote
+template<class RoundTrip>
+static void ForEachSerializer(RoundTrip&& roundTrip)
+{
+    auto same = [](auto& writer) { return writer; };
+
+    roundTrip(JsonSerializer(), same);
+    roundTrip(MsgPackSerializer(), same);
+    roundTrip(CborSerializer(), same);
+    roundTrip(ColumnarSerializer(), same);
+    roundTrip(ZeroCopySerializer(), [](ZeroCopySerializer& writer) { return ZeroCopySerializer::Parse(writer.Dump()); });
+    for(auto mode : { BinarySerializer::Mode::Positional, BinarySerializer::Mode::Named, BinarySerializer::Mode::Schema })
+    {
+        for(auto encoding : { BinarySerializer::IntegerEncoding::Fixed, BinarySerializer::IntegerEncoding::Varint })
+            roundTrip(BinarySerializer(mode, encoding), same);
+    }
+}
+
+//A schema can't describe arrays of objects, so a binary serializer in schema mode turns them down as they're written
+static bool IsSchemaMode(const BinarySerializer& serializer)
+{
+    return serializer.GetMode() == BinarySerializer::Mode::Schema;
+}
+
+template<class SerializerT>
+static bool IsSchemaMode(const SerializerT&)
+{
+    return false;
+}
+
+//Whether SerializerT has a Deserialize taking a T
+template<class SerializerT, class T, class = void>
+struct CanDeserialize : std::false_type {};
+
+template<class SerializerT, class T>
+struct CanDeserialize<SerializerT, T, std::void_t<decltype(std::declval<SerializerT&>().Deserialize(std::string_view(), std::declval<T&>()))>> : std::true_type {};
+
 int main()
 {
     JsonSerializer serializer;
@@ -84,13 +309,1104 @@ int main()
     serializer2.PolyDeserialize<Foo>("foo", foo2);
     serializer.Merge(serializer2);
     assert(typeid(*foo) == typeid(*foo2));
+
+    {
+        ArenaJsonSerializer arena;
+        arena.Serialize("b", b);
+        arena.Serialize("f", f);
+
+        Bar b3;
+        arena.Deserialize("b", b3);
+        assert(b3.x == b.x && b3.y == b.y);
+        assert(arena.Dump() == R"({"b":{"x":300,"y":600},"f":{"x":300}})");
+    }
+    MonotonicArena::ThreadLocal().Reset();
+
+    {
+        FlatJsonSerializer flat;
+        flat.Serialize("test", test);
+        flat.Serialize("f", f);
+        flat.Serialize("b", b);
+
+        Bar b3;
+        flat.Deserialize("b", b3);
+        assert(b3.x == b.x && b3.y == b.y);
+
+        JsonSerializer tree;
+        tree.Serialize("test", test);
+        tree.Serialize("f", f);
+        tree.Serialize("b", b);
+        assert(flat.Dump() == tree.Dump());
+
+        std::vector<FlatJsonSerializer> parts(2);
+        parts[0].Serialize("z", b);
+        parts[1].Serialize("a", f);
+        flat.MergeAll(std::make_move_iterator(parts.begin()), std::make_move_iterator(parts.end()));
+        assert(flat.Dump() == R"({"a":{"x":300},"b":{"x":300,"y":600},"f":{"x":300},"test":20,"z":{"x":300,"y":600}})");
+    }
+
+    {
+        JsonSerializer left;
+        JsonSerializer right;
+        Bar b3;
+        b3.x = 1;
+        b3.y = 2;
+        left.Serialize("b", b3);
+        left.Serialize("test", test);
+
+        Foo f3;
+        f3.x = 5;
+        right.Serialize("b", f3);
+        right.Serialize("f", f);
+
+        //Shallow merges keep left's b as is, deep merges go into it
+        JsonSerializer shallow = left;
+        shallow.Merge(right);
+        assert(shallow.Data()["b"]["x"] == 1 && shallow.Data().contains("f"));
+
+        JsonSerializer deep = left;
+        deep.DeepMerge(right, JsonSerializer::MergeConflict::Overwrite);
+        assert(deep.Data()["b"]["x"] == 5 && deep.Data()["b"]["y"] == 2);
+
+        bool threw = false;
+        try
+        {
+            JsonSerializer(left).DeepMerge(right, JsonSerializer::MergeConflict::Throw);
+        }
+        catch(const std::runtime_error&)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        std::vector<JsonSerializer> parts = { left, right };
+        JsonSerializer all;
+        all.MergeAll(std::make_move_iterator(parts.begin()), std::make_move_iterator(parts.end()), JsonSerializer::MergeConflict::KeepExisting, true);
+        assert(all.Data()["b"]["x"] == 1 && all.Data()["b"]["y"] == 2);
+        assert(all.Data()["f"]["x"] == f.x && all.Data()["test"] == test);
+    }
+
+    {
+        //Many readers over one document, none of them modify it
+        const nlohmann::json document = serializer2.Data();
+        std::vector<std::thread> readers;
+        for(int i = 0; i < 4; i++)
+        {
+            readers.emplace_back([&document]()
+            {
+                JsonSerializer reader = JsonSerializer::Reader(document);
+                Bar b3;
+                reader.Deserialize("b", b3);
+                assert(b3.x == 300 && b3.y == 600);
+
+                Foo* foo3;
+                reader.PolyDeserialize<Foo>("foo", foo3);
+                assert(typeid(*foo3) == typeid(Bar));
+            });
+        }
+        for(auto& reader : readers)
+            reader.join();
+        assert(document == serializer2.Data());
+
+        JsonSerializer reader = JsonSerializer::Reader(document, JsonSerializer::MissingField::Skip);
+        int missing = 5;
+        reader.Deserialize("missing", missing);
+        assert(missing == 5);
+
+        reader.SetMissingFieldPolicy(JsonSerializer::MissingField::Throw);
+        bool threw = false;
+        try
+        {
+            reader.Deserialize("missing", missing);
+        }
+        catch(const std::out_of_range&)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
     {
         std::fstream stream("JsonTest.json", std::ios::out);
 
-        stream << serializer.Dump();
+        serializer.Dump(stream);
         stream.flush();
         stream.close();
         std::string output = serializer.Dump();
+
+        std::ostringstream compact;
+        serializer.Dump(compact);
+        assert(compact.str() == output);
+
+        std::ostringstream indented;
+        serializer.Dump(indented, JsonSerializer::DumpFormat::Indented);
+        assert(indented.str() == serializer.Dump(JsonSerializer::DumpFormat::Indented));
+    }
+
+    for(auto mode : { BinarySerializer::Mode::Positional, BinarySerializer::Mode::Named, BinarySerializer::Mode::Schema })
+    for(auto encoding : { BinarySerializer::IntegerEncoding::Fixed, BinarySerializer::IntegerEncoding::Varint })
+    for(auto byteOrder : { BinarySerializer::ByteOrder::Little, BinarySerializer::ByteOrder::Big })
+    {
+        BinarySerializer binary(mode, encoding, byteOrder);
+        binary.Serialize("test", test);
+        binary.Serialize("ip", ip);
+        binary.Serialize("f", f);
+        binary.Serialize("b", b);
+        binary.Serialize("bp", bp);
+        binary.PolySerialize<Foo>("foo", foo);
+        binary.Serialize("null", static_cast<const Bar*>(nullptr));
+        binary.Serialize("d", 0.25);
+
+        BinarySerializer tail(mode, encoding, byteOrder);
+        tail.Serialize("tail", static_cast<std::uint64_t>(0x0102030405060708));
+        binary.Merge(std::move(tail));
+
+        BinarySerializer copy = BinarySerializer::Parse(binary.Dump(), mode, encoding, byteOrder);
+
+        int test3;
+        int* ip3;
+        Foo f3;
+        Bar b3;
+        Bar* bp3;
+        Foo* foo3;
+        Bar* null3 = bp;
+        double d3;
+        std::uint64_t tail3;
+        copy.Deserialize("test", test3);
+        copy.Deserialize("ip", ip3);
+        copy.Deserialize("f", f3);
+        copy.Deserialize("b", b3);
+        copy.Deserialize("bp", bp3);
+        copy.PolyDeserialize<Foo>("foo", foo3);
+        copy.Deserialize("null", null3);
+        copy.Deserialize("d", d3);
+        copy.Deserialize("tail", tail3);
+
+        assert(test3 == test && *ip3 == *ip && f3.x == f.x);
+        assert(b3.x == b.x && b3.y == b.y && bp3->x == bp->x && bp3->y == bp->y);
+        assert(typeid(*foo3) == typeid(*foo) && null3 == nullptr && d3 == 0.25);
+        assert(tail3 == 0x0102030405060708);
+    }
+
+    {
+        //Little endian no matter the machine
+        BinarySerializer binary;
+        binary.Serialize("x", static_cast<std::uint32_t>(0x11223344));
+        assert(binary.Dump() == std::string("\x44\x33\x22\x11", 4));
+
+        BinarySerializer named(BinarySerializer::Mode::Named);
+        named.Serialize("x", 1);
+        bool threw = false;
+        try
+        {
+            int y;
+            named.Deserialize("y", y);
+        }
+        catch(const std::runtime_error&)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    {
+        //Varints take a byte up to 127, and zigzag keeps small negatives small
+        BinarySerializer varint(BinarySerializer::Mode::Positional, BinarySerializer::IntegerEncoding::Varint);
+        varint.Serialize("a", 100);
+        varint.Serialize("b", -2);
+        varint.Serialize("c", static_cast<std::uint16_t>(300));
+        assert(varint.Dump() == std::string("\xc8\x01\x03\xac\x02", 5));
+
+        //Per field annotation, even when the serializer is full width
+        BinarySerializer fixed;
+        Bar small;
+        small.x = 1;
+        small.y = -1;
+        fixed.Serialize("small", small);
+        assert(fixed.Dump().size() == 5);
+
+        std::vector<std::int32_t> ids;
+        for(int i = 0; i < 1000; i++)
+            ids.push_back((i % 7 == 0) ? -i * 1000 : i % 50);
+
+        BinarySerializer bulk;
+        bulk.SerializeVarints("ids", ids.data(), ids.size());
+        bulk.Serialize("after", 5);
+
+        std::vector<std::int32_t> ids3;
+        int after;
+        bulk.DeserializeVarints("ids", ids3);
+        bulk.Deserialize("after", after);
+        assert(ids3 == ids && after == 5);
+    }
+
+    {
+        //The schema of a type is described once per stream, every record after that is just its index and data
+        BinarySerializer schema(BinarySerializer::Mode::Schema);
+        std::size_t sizes[3];
+        for(int i = 0; i < 3; i++)
+        {
+            std::size_t before = schema.Data().size();
+            schema.Serialize("p", PointV1{ i, i * 2, "point" });
+            sizes[i] = schema.Data().size() - before;
+        }
+        assert(sizes[1] == 4 + 4 + 4 + 4 + 5 && sizes[2] == sizes[1] && sizes[0] > sizes[1]);
+
+        //Same layout as the writer, positional after the first record
+        for(int i = 0; i < 3; i++)
+        {
+            PointV1 p;
+            schema.Deserialize("p", p);
+            assert(p.x == i && p.y == i * 2 && p.name == "point");
+        }
+
+        //A warm layout asked for under another name isn't read positionally, the record has nothing by that name
+        schema.Rewind();
+        for(int i = 0; i < 3; i++)
+        {
+            PointV1 p{ -1, -1, "untouched" };
+            schema.Deserialize((i == 1) ? "q" : "p", p);
+            if(i == 1)
+                assert(p.x == -1 && p.y == -1 && p.name == "untouched");
+            else
+                assert(p.x == i && p.y == i * 2 && p.name == "point");
+        }
+
+        //Different layout, fields are matched by name, widened, and missing ones are left alone
+        schema.Rewind();
+        for(int i = 0; i < 3; i++)
+        {
+            PointV2 p;
+            schema.Deserialize("p", p);
+            assert(p.name == "point" && p.y == i * 2 && p.z == 7);
+        }
+
+        //Fields a base class doesn't know about are skipped
+        BinarySerializer derived(BinarySerializer::Mode::Schema);
+        derived.Serialize("b", b);
+        derived.Serialize("after", 5);
+        Foo f3;
+        int after;
+        derived.Deserialize("b", f3);
+        derived.Deserialize("after", after);
+        assert(f3.x == b.x && after == 5);
+
+        //Merged records are renumbered against the schemas we've already described
+        BinarySerializer merged(BinarySerializer::Mode::Schema);
+        merged.Serialize("after", 1);
+        merged.Merge(schema);
+        merged.Merge(schema);
+        for(int i = 0; i < 7; i++)
+        {
+            if(i == 0)
+            {
+                merged.Deserialize("after", after);
+                assert(after == 1);
+                continue;
+            }
+
+            PointV1 p;
+            merged.Deserialize("p", p);
+            assert(p.x == (i - 1) % 3 && p.name == "point");
+        }
+    }
+
+    {
+        ColumnarSerializer columnar;
+        columnar.Serialize("test", test);
+        columnar.Serialize("ip", ip);
+        columnar.Serialize("f", f);
+        columnar.Serialize("b", b);
+        columnar.Serialize("bp", bp);
+        columnar.PolySerialize<Foo>("foo", foo);
+        columnar.Serialize("null", static_cast<const Bar*>(nullptr));
+        columnar.Serialize("s", std::string("text"));
+
+        ColumnarSerializer copy = ColumnarSerializer::Parse(columnar.Dump());
+
+        int test3;
+        int* ip3;
+        Foo f3;
+        Bar b3;
+        Bar* bp3;
+        Foo* foo3;
+        Bar* null3 = bp;
+        std::string s3;
+        copy.Deserialize("test", test3);
+        copy.Deserialize("ip", ip3);
+        copy.Deserialize("f", f3);
+        copy.Deserialize("b", b3);
+        copy.Deserialize("bp", bp3);
+        copy.PolyDeserialize<Foo>("foo", foo3);
+        copy.Deserialize("null", null3);
+        copy.Deserialize("s", s3);
+
+        assert(test3 == test && *ip3 == *ip && f3.x == f.x && s3 == "text");
+        assert(b3.x == b.x && b3.y == b.y && bp3->x == bp->x && bp3->y == bp->y);
+        assert(typeid(*foo3) == typeid(*foo) && null3 == nullptr);
+    }
+
+    {
+        //A collection is one column per field, ids which count up are a byte each
+        std::vector<Bar> records(1000);
+        for(int i = 0; i < 1000; i++)
+        {
+            records[i].x = 1000000 + i;
+            records[i].y = (i % 3) - 1;
+        }
+
+        ColumnarSerializer columnar;
+        columnar.SerializeRecords("records", records);
+        assert(columnar.Data().size() < 2100);
+
+        std::vector<Bar> records3;
+        columnar.DeserializeRecords("records", records3);
+        assert(records3.size() == records.size());
+        for(std::size_t i = 0; i < records.size(); i++)
+            assert(records3[i].x == records[i].x && records3[i].y == records[i].y);
+
+        //Or straight into columns
+        std::vector<int> xs;
+        std::vector<int> ys;
+        columnar.Rewind();
+        columnar.DeserializeColumns("records", "x", xs, "y", ys);
+        assert(xs.size() == 1000 && xs[999] == 1000999 && ys[2] == 1);
+
+        //Which can be written back as records
+        ColumnarSerializer soa;
+        soa.SerializeColumns("records", "x", xs, "y", ys);
+        std::vector<Bar> records4;
+        soa.DeserializeRecords("records", records4);
+        assert(records4.size() == 1000 && records4[999].x == 1000999 && records4[2].y == 1);
+
+        //A corrupt record or column count is turned down before anything is sized for it
+        std::string bytes = columnar.Dump();
+        for(std::size_t offset : { std::size_t(4 + 7), std::size_t(4 + 7 + 4) })
+        {
+            std::string corrupt = bytes;
+            corrupt.replace(offset, 4, "\xff\xff\xff\x7f");
+
+            ColumnarSerializer reader = ColumnarSerializer::Parse(corrupt);
+            std::vector<Bar> records5;
+            bool threw = false;
+            try { reader.DeserializeRecords("records", records5); } catch(const std::out_of_range&) { threw = true; }
+            assert(threw && records5.empty());
+        }
+    }
+
+    {
+        //Copying a trivially serializable object gives the same bytes as writing its fields
+        std::vector<Pixel> pixels(100);
+        std::vector<SlowPixel> slowPixels(100);
+        for(int i = 0; i < 100; i++)
+        {
+            pixels[i] = Pixel{ i, -i, 1, 2, 3, static_cast<std::uint16_t>(i * 600) };
+            static_cast<Pixel&>(slowPixels[i]) = pixels[i];
+        }
+
+        BinarySerializer fast;
+        BinarySerializer slow;
+        fast.Serialize("pixel", pixels[5]);
+        slow.Serialize("pixel", slowPixels[5]);
+        fast.SerializeArray("pixels", pixels.data(), pixels.size());
+        slow.SerializeArray("pixels", slowPixels.data(), slowPixels.size());
+        assert(fast.Dump() == slow.Dump() && fast.Dump().size() == 16 + 4 + 100 * 16);
+
+        Pixel pixel;
+        std::vector<Pixel> pixels3;
+        fast.Deserialize("pixel", pixel);
+        fast.DeserializeArray("pixels", pixels3);
+        assert(pixel.y == -5 && pixels3.size() == 100 && pixels3[99].a == static_cast<std::uint16_t>(99 * 600));
+
+        //Modes which don't lay objects out as they are in memory still go field by field
+        BinarySerializer named(BinarySerializer::Mode::Named);
+        named.SerializeArray("pixels", pixels.data(), pixels.size());
+        std::vector<Pixel> pixels4;
+        named.DeserializeArray("pixels", pixels4);
+        assert(pixels4.size() == 100 && pixels4[42].x == 42 && pixels4[42].a == static_cast<std::uint16_t>(42 * 600));
+
+        //A count too big for what's left is turned down before it's multiplied by the object size
+        std::string corrupt = fast.Dump();
+        corrupt.replace(16, 4, "\xff\xff\xff\xff");
+        BinarySerializer corruptReader = BinarySerializer::Parse(corrupt);
+        std::vector<Pixel> pixels5;
+        bool threw = false;
+        try
+        {
+            corruptReader.Deserialize("pixel", pixel);
+            corruptReader.DeserializeArray("pixels", pixels5);
+        }
+        catch(const std::out_of_range&)
+        {
+            threw = true;
+        }
+        assert(threw && pixels5.empty());
+    }
+
+    {
+        BinarySerializer big(BinarySerializer::Mode::Positional, BinarySerializer::IntegerEncoding::Fixed, BinarySerializer::ByteOrder::Big);
+        big.Serialize("x", static_cast<std::uint32_t>(0x11223344));
+        assert(big.Dump() == std::string("\x11\x22\x33\x44", 4));
+
+        //Every kernel this machine has swaps the same as one value at a time
+        std::vector<std::uint16_t> shorts;
+        std::vector<std::int32_t> ints;
+        std::vector<double> doubles;
+        for(int i = 0; i < 1001; i++)
+        {
+            shorts.push_back(static_cast<std::uint16_t>(i * 0x0102));
+            ints.push_back(static_cast<std::int32_t>(static_cast<std::uint32_t>(i) * 0xfefdfcfdu));
+            doubles.push_back(i * 0.125);
+        }
+
+        ByteSwap::Kernel selected = ByteSwap::SelectedKernel();
+        for(auto kernel : { ByteSwap::Kernel::Scalar, ByteSwap::Kernel::Ssse3, ByteSwap::Kernel::Avx2 })
+        {
+            if(!ByteSwap::Select(kernel))
+                continue;
+
+            BinarySerializer arrays(BinarySerializer::Mode::Positional, BinarySerializer::IntegerEncoding::Fixed, BinarySerializer::ByteOrder::Big);
+            arrays.SerializeArray("shorts", shorts.data(), shorts.size());
+            arrays.SerializeArray("ints", ints.data(), ints.size());
+            arrays.SerializeArray("doubles", doubles.data(), doubles.size());
+
+            BinarySerializer single(BinarySerializer::Mode::Positional, BinarySerializer::IntegerEncoding::Fixed, BinarySerializer::ByteOrder::Big);
+            single.Serialize("count", static_cast<std::uint32_t>(shorts.size()));
+            for(auto value : shorts)
+                single.Serialize("value", value);
+            assert(arrays.Dump().compare(0, single.Dump().size(), single.Dump()) == 0);
+
+            std::vector<std::uint16_t> shorts3;
+            std::vector<std::int32_t> ints3;
+            std::vector<double> doubles3;
+            arrays.DeserializeArray("shorts", shorts3);
+            arrays.DeserializeArray("ints", ints3);
+            arrays.DeserializeArray("doubles", doubles3);
+            assert(shorts3 == shorts && ints3 == ints && doubles3 == doubles);
+        }
+        ByteSwap::Select(selected);
+
+        //Trivially serializable objects aren't copied as they are into a stream of the other byte order
+        BinarySerializer bigPixel(BinarySerializer::Mode::Positional, BinarySerializer::IntegerEncoding::Fixed, BinarySerializer::ByteOrder::Big);
+        BinarySerializer bigSlowPixel(BinarySerializer::Mode::Positional, BinarySerializer::IntegerEncoding::Fixed, BinarySerializer::ByteOrder::Big);
+        bigPixel.Serialize("pixel", Pixel{ 1, 2, 3, 4, 5, 6 });
+        bigSlowPixel.Serialize("pixel", SlowPixel{ { 1, 2, 3, 4, 5, 6 } });
+        assert(bigPixel.Dump() == bigSlowPixel.Dump() && bigPixel.Dump()[3] == 1);
+    }
+
+    {
+        MsgPackSerializer msgpack;
+        msgpack.Serialize("test", test);
+        msgpack.Serialize("ip", ip);
+        msgpack.Serialize("f", f);
+        msgpack.Serialize("b", b);
+        msgpack.Serialize("bp", bp);
+        msgpack.PolySerialize<Foo>("foo", foo);
+        msgpack.Serialize("null", static_cast<const Bar*>(nullptr));
+        msgpack.Serialize("d", 0.25);
+        msgpack.Serialize("pi", 3.14159265358979);
+        msgpack.Serialize("big", static_cast<std::int64_t>(-5000000000));
+
+        MsgPackSerializer tail;
+        tail.Serialize("tail", static_cast<std::uint64_t>(0x0102030405060708));
+        tail.Serialize("test", test + 1);
+        msgpack.Merge(tail);
+
+        MsgPackSerializer copy = MsgPackSerializer::Parse(msgpack.Dump());
+
+        //Out of order on purpose, the reader has to go back and look
+        int test3;
+        int* ip3;
+        Foo f3;
+        Bar b3;
+        Bar* bp3;
+        Foo* foo3;
+        Bar* null3 = bp;
+        double d3;
+        double pi3;
+        std::int64_t big3;
+        std::uint64_t tail3;
+        copy.Deserialize("tail", tail3);
+        copy.Deserialize("test", test3);
+        copy.Deserialize("ip", ip3);
+        copy.Deserialize("b", b3);
+        copy.Deserialize("f", f3);
+        copy.Deserialize("bp", bp3);
+        copy.PolyDeserialize<Foo>("foo", foo3);
+        copy.Deserialize("null", null3);
+        copy.Deserialize("d", d3);
+        copy.Deserialize("pi", pi3);
+        copy.Deserialize("big", big3);
+
+        assert(test3 == test && *ip3 == *ip && f3.x == f.x);
+        assert(b3.x == b.x && b3.y == b.y && bp3->x == bp->x && bp3->y == bp->y);
+        assert(typeid(*foo3) == typeid(*foo) && null3 == nullptr);
+        assert(d3 == 0.25 && pi3 == 3.14159265358979 && big3 == -5000000000 && tail3 == 0x0102030405060708);
+
+        //Smallest encodings: fixint, negative fixint, uint16, float32 for exact doubles, float64 otherwise
+        MsgPackSerializer small;
+        small.Serialize("a", 5);
+        small.Serialize("b", -3);
+        small.Serialize("c", 300);
+        small.Serialize("d", 0.5);
+        small.Serialize("e", 0.1);
+        assert(small.Dump() == std::string("\x85\xa1" "a" "\x05\xa1" "b" "\xfd\xa1" "c" "\xcd\x01\x2c"
+                                           "\xa1" "d" "\xca\x3f\x00\x00\x00\xa1" "e" "\xcb\x3f\xb9\x99\x99\x99\x99\x99\x9a", 30));
+
+        bool threw = false;
+        try
+        {
+            std::int8_t narrow;
+            small.Deserialize("c", narrow);
+        }
+        catch(const std::out_of_range&)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        //Doubles beyond float's range, and the ones a float can still hold exactly, round trip
+        MsgPackSerializer extremes;
+        extremes.Serialize("huge", 1e300);
+        extremes.Serialize("tiny", -1e300);
+        extremes.Serialize("max", static_cast<double>(std::numeric_limits<float>::max()));
+        extremes.Serialize("inf", std::numeric_limits<double>::infinity());
+        extremes.Serialize("nan", std::numeric_limits<double>::quiet_NaN());
+        double huge, tiny, max, inf, nan;
+        extremes.Deserialize("huge", huge);
+        extremes.Deserialize("tiny", tiny);
+        extremes.Deserialize("max", max);
+        extremes.Deserialize("inf", inf);
+        extremes.Deserialize("nan", nan);
+        assert(huge == 1e300 && tiny == -1e300 && max == std::numeric_limits<float>::max());
+        assert(inf == std::numeric_limits<double>::infinity() && std::isnan(nan));
+
+        //Skipping over a value nested far deeper than the stack could recurse doesn't overflow it
+        std::string deep("\x82\xa4" "deep", 6);
+        deep.append(1000000, '\x91');
+        deep.append("\x01\xa1" "x" "\x07", 4);
+        int x = 0;
+        MsgPackSerializer::Parse(deep).Deserialize("x", x);
+        assert(x == 7);
+    }
+
+    {
+        CborSerializer cbor;
+        cbor.Serialize("test", test);
+        cbor.Serialize("ip", ip);
+        cbor.Serialize("f", f);
+        cbor.Serialize("b", b);
+        cbor.Serialize("bp", bp);
+        cbor.PolySerialize<Foo>("foo", foo);
+        cbor.Serialize("null", static_cast<const Bar*>(nullptr));
+        cbor.Serialize("pi", 3.14159265358979);
+        cbor.Serialize("big", static_cast<std::int64_t>(-5000000000));
+        cbor.Serialize("name", std::string("telemetry"));
+
+        CborSerializer::bytes_type blob(1000);
+        for(std::size_t i = 0; i < blob.size(); i++)
+            blob[i] = static_cast<std::byte>(i * 7);
+        cbor.Serialize("blob", blob);
+
+        CborSerializer copy = CborSerializer::Parse(cbor.Dump());
+
+        int test3;
+        int* ip3;
+        Foo f3;
+        Bar b3;
+        Bar* bp3;
+        Foo* foo3;
+        Bar* null3 = bp;
+        double pi3;
+        std::int64_t big3;
+        std::string name3;
+        CborSerializer::bytes_type blob3;
+        copy.Deserialize("blob", blob3);
+        copy.Deserialize("test", test3);
+        copy.Deserialize("ip", ip3);
+        copy.Deserialize("f", f3);
+        copy.Deserialize("b", b3);
+        copy.Deserialize("bp", bp3);
+        copy.PolyDeserialize<Foo>("foo", foo3);
+        copy.Deserialize("null", null3);
+        copy.Deserialize("pi", pi3);
+        copy.Deserialize("big", big3);
+        copy.Deserialize("name", name3);
+
+        assert(test3 == test && *ip3 == *ip && f3.x == f.x);
+        assert(b3.x == b.x && b3.y == b.y && bp3->x == bp->x && bp3->y == bp->y);
+        assert(typeid(*foo3) == typeid(*foo) && null3 == nullptr);
+        assert(pi3 == 3.14159265358979 && big3 == -5000000000 && name3 == "telemetry" && blob3 == blob);
+
+        //Preferred serialization: immediate and 1 byte heads, -1 - n negatives, half floats when exact, 3 byte blob head
+        CborSerializer small;
+        small.Serialize("a", 10);
+        small.Serialize("b", -500);
+        small.Serialize("c", 1.5);
+        small.Serialize("d", CborSerializer::bytes_type(2, std::byte{ 0xab }));
+        assert(small.Dump() == std::string("\xa4\x61" "a" "\x0a\x61" "b" "\x39\x01\xf3\x61" "c" "\xf9\x3e\x00\x61" "d" "\x42\xab\xab", 19));
+
+        //Other encoders may write indefinite length maps and strings
+        CborSerializer streamed = CborSerializer::Parse(std::string("\xbf\x61" "s" "\x7f\x62" "ab" "\x61" "c" "\xff\x61" "n" "\x18\x64\xff", 15));
+        std::string s3;
+        int n3;
+        streamed.Deserialize("n", n3);
+        streamed.Deserialize("s", s3);
+        assert(s3 == "abc" && n3 == 100);
+    }
+
+    {
+        ZeroCopySerializer zeroCopy;
+        zeroCopy.Serialize("test", test);
+        zeroCopy.Serialize("ip", ip);
+        zeroCopy.Serialize("f", f);
+        zeroCopy.Serialize("b", b);
+        zeroCopy.Serialize("bp", bp);
+        zeroCopy.PolySerialize<Foo>("foo", foo);
+        zeroCopy.Serialize("null", static_cast<const Bar*>(nullptr));
+        zeroCopy.Serialize("d", 0.25);
+        zeroCopy.Serialize("name", std::string("snapshot"));
+
+        ZeroCopySerializer tail;
+        tail.Serialize("tail", static_cast<std::uint64_t>(0x0102030405060708));
+        tail.Serialize("test", test + 1);
+        zeroCopy.Merge(tail);
+
+        {
+            std::ofstream file("ZeroCopyTest.bin", std::ios::out | std::ios::binary);
+            zeroCopy.Dump(file);
+        }
+
+        //Straight out of the mapping, nothing parsed or copied
+        MappedFile mapped("ZeroCopyTest.bin", MappedFile::Access::Random);
+        auto root = ZeroCopyView<>::Root(mapped.View());
+        assert(root.Get<int>("test") == test && root.Get<double>("d") == 0.25);
+        assert(root.Get<std::uint64_t>("tail") == 0x0102030405060708);
+        assert(root.GetString("name") == "snapshot" && root.IsNull("null") && !root.Has("missing"));
+        assert(root.GetView<Bar>("b").Get<int>("y") == b.y && root.GetView<Foo>("foo").GetString("Type") == typeid(*foo).name());
+
+        //Falls back to real objects when they're needed
+        Bar owned = root.GetView<Bar>("bp").Deserialize();
+        assert(owned.x == bp->x && owned.y == bp->y);
+
+        ZeroCopySerializer reader = ZeroCopySerializer::Reader(mapped.View());
+        int test3;
+        int* ip3;
+        Foo f3;
+        Bar b3;
+        Bar* bp3;
+        Foo* foo3;
+        Bar* null3 = bp;
+        std::string name3;
+        reader.Deserialize("name", name3);
+        reader.Deserialize("test", test3);
+        reader.Deserialize("ip", ip3);
+        reader.Deserialize("f", f3);
+        reader.Deserialize("b", b3);
+        reader.Deserialize("bp", bp3);
+        reader.PolyDeserialize<Foo>("foo", foo3);
+        reader.Deserialize("null", null3);
+
+        assert(test3 == test && *ip3 == *ip && f3.x == f.x && name3 == "snapshot");
+        assert(b3.x == b.x && b3.y == b.y && bp3->x == bp->x && bp3->y == bp->y);
+        assert(typeid(*foo3) == typeid(*foo) && null3 == nullptr);
+    }
+
+    {
+        JsonSerializer loaded = JsonSerializer::LoadFile("JsonTest.json");
+        assert(loaded.Data() == serializer.Data());
+        assert(JsonSerializer::LoadMapped("JsonTest.json").Data() == serializer.Data());
+
+        Bar b3;
+        Foo* foo3;
+        int test3 = 0;
+        JsonStreamLoader loader;
+        loader.Deserialize("b", b3);
+        loader.PolyDeserialize<Foo>("foo", foo3);
+        loader.Deserialize("test", test3);
+        loader.LoadFile("JsonTest.json");
+
+        assert(b3.x == b.x && b3.y == b.y);
+        assert(typeid(*foo3) == typeid(*foo));
+        assert(test3 == test);
+    }
+
+    {
+        //Small blocks and several threads, so the snapshots span many blocks compressed in parallel
+        BlockCompressor<> compressor(256, 4);
+
+        BinarySerializer named(BinarySerializer::Mode::Named);
+        JsonSerializer json;
+        for(int i = 0; i < 200; i++)
+        {
+            Bar bar;
+            bar.x = i;
+            bar.y = i * 2;
+            named.Serialize("bar", bar);
+            json.Serialize("bar" + std::to_string(i), bar);
+        }
+
+        std::string packed = compressor.Compress(named.Dump());
+        assert(packed.size() * 2 < named.Dump().size());
+        BinarySerializer unpacked = BinarySerializer::Parse(compressor.Decompress(packed), BinarySerializer::Mode::Named);
+        for(int i = 0; i < 200; i++)
+        {
+            Bar bar;
+            unpacked.Deserialize("bar", bar);
+            assert(bar.x == i && bar.y == i * 2);
+        }
+
+        std::string jsonPacked = BlockCompressor<>().Compress(json.Dump());
+        assert(jsonPacked.size() < json.Dump().size() && JsonSerializer::Parse(compressor.Decompress(jsonPacked)).Data() == json.Data());
+
+        //Empty input, a run only an overlapping match can cover, and noise that has to be stored as is
+        std::string noise(1000, '\0');
+        std::uint32_t state = 1;
+        for(char& c : noise)
+        {
+            state = state * 1664525u + 1013904223u;
+            c = static_cast<char>(state >> 24);
+        }
+        for(const std::string& raw : { std::string(), std::string(5000, 'a'), std::string("abcabcabcabcabcabcabcabcab"), noise, noise + std::string(300, 'z') + noise })
+            assert(compressor.Decompress(compressor.Compress(raw)) == raw);
+        assert(compressor.Compress(noise).size() < noise.size() + 64);
+
+        bool threw = false;
+        try
+        {
+            std::string truncated = compressor.Compress(std::string(5000, 'a'));
+            truncated.pop_back();
+            compressor.Decompress(truncated);
+        }
+        catch(const std::runtime_error&)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        //Headers whose sizes the block table can't back up are turned down before the output is allocated.
+        //A block size the compressor never writes, a stored block of the wrong size, and a compressed block too small to grow that big
+        auto header = [](std::uint32_t blockSize, std::uint64_t size, std::uint32_t entry, std::size_t payload)
+        {
+            std::string bytes(1, '\x01');
+            for(int i = 0; i < 4; i++)
+                bytes.push_back(static_cast<char>(blockSize >> (8 * i)));
+            for(int i = 0; i < 8; i++)
+                bytes.push_back(static_cast<char>(size >> (8 * i)));
+            for(int i = 0; i < 4; i++)
+                bytes.push_back(static_cast<char>(entry >> (8 * i)));
+            return bytes + std::string(payload, '\0');
+        };
+        for(const std::string& crafted : { header(0xFFFFFFFFu, 0xFFFFFFFFu, 0, 0), header(0x7FFFFFFFu, 0x7FFFFFFFu, 0x80000001u, 1), header(0x7FFFFFFFu, 0x7FFFFFFFu, 1, 1) })
+        {
+            threw = false;
+            try { compressor.Decompress(crafted); } catch(const std::runtime_error&) { threw = true; }
+            assert(threw);
+        }
+    }
+
+    {
+        //Known answer for CRC32C, from every kernel and in pieces
+        Crc32c::Kernel selected = Crc32c::SelectedKernel();
+        for(Crc32c::Kernel kernel : { Crc32c::Kernel::Slicing8, Crc32c::Kernel::Sse42 })
+        {
+            if(!Crc32c::Select(kernel))
+                continue;
+
+            assert(Crc32c::Compute("123456789", 9) == 0xE3069283u);
+            std::string text = "The quick brown fox jumps over the lazy dog, twice over the lazy dog";
+            assert(Crc32c::Compute(text.data() + 5, text.size() - 5, Crc32c::Compute(text.data(), 5)) == Crc32c::Compute(text.data(), text.size()));
+        }
+        Crc32c::Select(selected);
+
+        std::ostringstream log;
+        RecordWriter writer(log);
+        for(int i = 0; i < 50; i++)
+        {
+            BinarySerializer record;
+            Bar bar;
+            bar.x = i;
+            bar.y = -i;
+            record.Serialize("bar", bar);
+            writer.Append(record);
+        }
+
+        std::string bytes = log.str();
+        std::size_t frameSize = bytes.size() / 50;
+
+        //Flip a payload byte in record 10, wreck record 20's header, put junk between 30 and 31 and tear the last one
+        bytes[10 * frameSize + RecordFrame::headerSize + 1] ^= 0x40;
+        bytes[20 * frameSize + 5] ^= 0x01;
+        bytes.insert(31 * frameSize, std::string(37, '\xC3'));
+        bytes.resize(bytes.size() - 3);
+
+        RecordReader reader(bytes);
+        std::vector<int> seen;
+        BinarySerializer record;
+        while(reader.Next(record))
+        {
+            Bar bar;
+            record.Deserialize("bar", bar);
+            assert(bar.y == -bar.x);
+            seen.push_back(bar.x);
+        }
+        assert(seen.size() == 47 && reader.CorruptFrames() == 3);
+        assert(std::find(seen.begin(), seen.end(), 10) == seen.end() && std::find(seen.begin(), seen.end(), 20) == seen.end());
+        assert(seen.front() == 0 && seen.back() == 48);
+
+        //Starting part way into record 40 picks up again at 41
+        RecordReader middle(bytes, 40 * frameSize + 37 + 7);
+        std::string_view payload;
+        assert(middle.Next(payload) && middle.SkippedBytes() == frameSize - 7);
+        assert(payload.size() == frameSize - RecordFrame::headerSize);
+    }
+
+    {
+        //Arrays of numbers round trip through every serializer, whichever container they're in
+        Samples samples{ { 5, -3, 70000, 0 }, { 0.5, -1.25, 3.0 }, { 80, 443 }, { -(1ll << 40), 0, 1 } };
+        const int fixed[3] = { 1, 2, 3 };
+        auto roundTrip = [&](auto writer, auto reopen)
+        {
+            writer.Serialize("samples", samples);
+            writer.Serialize("fixed", fixed);
+            writer.Serialize("empty", std::vector<float>());
+
+            auto reader = reopen(writer);
+            Samples read;
+            int fixedRead[3] = {};
+            std::vector<float> empty{ 1.0f };
+            reader.Deserialize("samples", read);
+            reader.Deserialize("fixed", fixedRead);
+            reader.Deserialize("empty", empty);
+            assert(read == samples && std::equal(fixed, fixed + 3, fixedRead) && empty.empty());
+        };
+        ForEachSerializer(roundTrip);
+
+        //std::array and C arrays need exactly as many values as they hold
+        MsgPackSerializer tooShort;
+        tooShort.Serialize("fixed", std::vector<int>{ 1, 2 });
+        int three[3];
+        bool threw = false;
+        try { tooShort.Deserialize("fixed", three); } catch(const std::runtime_error&) { threw = true; }
+        assert(threw);
+
+        //Schema records read by a different layout skip the arrays they don't want and widen the ones they do
+        BinarySerializer schema(BinarySerializer::Mode::Schema, BinarySerializer::IntegerEncoding::Varint);
+        schema.Serialize("s", samples);
+        WideSamples wide;
+        schema.Deserialize("s", wide);
+        assert(wide.ids.size() == 4 && wide.ids[2] == 70000 && wide.ids[1] == -3 && wide.extra == 9);
+
+        //Every record's arrays share one column
+        std::vector<Samples> many(100, samples);
+        many[50].ids.clear();
+        ColumnarSerializer columnar;
+        columnar.SerializeRecords("many", many);
+        std::vector<Samples> manyRead;
+        columnar.DeserializeRecords("many", manyRead);
+        assert(manyRead == many);
+
+        JsonSerializer file = JsonSerializer::LoadFile("testJson.json");
+        std::vector<int> values;
+        std::array<int, 4> valueArray;
+        file.Deserialize("values", values);
+        file.Deserialize("values", valueArray);
+        assert((values == std::vector<int>{ 5, 3, 7, 10 }) && std::equal(values.begin(), values.end(), valueArray.begin()));
+
+        JsonSerializer resaved;
+        resaved.Serialize("values", values);
+        assert(resaved.Data()["values"] == file.Data()["values"]);
+    }
+
+    {
+        //Containers of objects and object pointers, contiguous or not, round trip through every serializer
+        std::vector<Bar> bars(5);
+        for(int i = 0; i < 5; i++)
+        {
+            bars[i].x = i * 100;
+            bars[i].y = -i;
+        }
+        std::deque<Bar> barDeque(bars.begin(), bars.end());
+        std::list<Bar*> barPointers{ &bars[0], nullptr, &bars[4] };
+        std::vector<Foo> noFoos;
+
+        auto sameBar = [](const Bar& a, const Bar& b) { return a.x == b.x && a.y == b.y; };
+        auto roundTrip = [&](auto writer, auto reopen)
+        {
+            if(IsSchemaMode(writer))
+            {
+                bool threw = false;
+                try { writer.Serialize("bars", bars); } catch(const std::logic_error&) { threw = true; }
+                assert(threw);
+
+                threw = false;
+                try { writer.Serialize("pointers", barPointers); } catch(const std::logic_error&) { threw = true; }
+                assert(threw);
+                return;
+            }
+
+            writer.Serialize("bars", bars);
+            writer.Serialize("deque", barDeque);
+            writer.Serialize("pointers", barPointers);
+            writer.Serialize("none", noFoos);
+
+            auto reader = reopen(writer);
+            std::vector<Bar> barsRead(2);
+            std::deque<Bar> dequeRead;
+            std::list<Bar*> pointersRead;
+            std::vector<Foo> noneRead(3);
+            reader.Deserialize("bars", barsRead);
+            reader.Deserialize("deque", dequeRead);
+            reader.Deserialize("pointers", pointersRead);
+            reader.Deserialize("none", noneRead);
+
+            assert(std::equal(bars.begin(), bars.end(), barsRead.begin(), barsRead.end(), sameBar));
+            assert(std::equal(bars.begin(), bars.end(), dequeRead.begin(), dequeRead.end(), sameBar));
+            assert(pointersRead.size() == 3 && noneRead.empty());
+            auto pointer = pointersRead.begin();
+            assert(sameBar(**pointer, bars[0]) && *++pointer == nullptr && sameBar(**++pointer, bars[4]));
+        };
+        ForEachSerializer(roundTrip);
+
+        //A whole block of records, each with a container of objects in it, share the element columns
+        std::vector<std::vector<Bar>> nested{ bars, {}, bars };
+        ColumnarSerializer columnar;
+        columnar.SerializeRecords("nested", nested);
+        std::vector<std::vector<Bar>> nestedRead;
+        columnar.DeserializeRecords("nested", nestedRead);
+        assert(nestedRead.size() == 3 && nestedRead[1].empty() && std::equal(bars.begin(), bars.end(), nestedRead[2].begin(), nestedRead[2].end(), sameBar));
+    }
+
+    {
+        //Maps keyed by strings or integers, with values of any type a field can have, round trip through every serializer
+        std::map<std::string, int> counts{ { "apples", 3 }, { "pears", -7 }, { "", 0 } };
+        std::unordered_map<std::string, Bar> named;
+        named["first"].x = 1;
+        named["first"].y = 2;
+        named["second"].x = 3;
+        named["second"].y = 4;
+        FlatMap<int, std::string> labels{ { -5, "minus five" }, { 12, "twelve" } };
+        //FlatMap's iterators only give out its keys as const, like std::map's
+        static_assert(!std::is_assignable_v<decltype((labels.begin()->first)), int>);
+        static_assert(std::is_assignable_v<decltype((labels.begin()->second)), std::string>);
+        std::unordered_map<std::uint64_t, double> weights;
+        for(std::uint64_t i = 0; i < 100; i++)
+            weights[i * 1000003] = i * 0.5;
+
+        auto roundTrip = [&](auto writer, auto reopen)
+        {
+            if(IsSchemaMode(writer))
+            {
+                bool threw = false;
+                try { writer.Serialize("counts", counts); } catch(const std::logic_error&) { threw = true; }
+                assert(threw);
+                return;
+            }
+
+            writer.Serialize("counts", counts);
+            writer.Serialize("named", named);
+            writer.Serialize("labels", labels);
+            writer.Serialize("weights", weights);
+
+            auto reader = reopen(writer);
+            std::map<std::string, int> countsRead{ { "stale", 1 } };
+            std::unordered_map<std::string, Bar> namedRead;
+            FlatMap<int, std::string> labelsRead;
+            std::unordered_map<std::uint64_t, double> weightsRead;
+            reader.Deserialize("counts", countsRead);
+            reader.Deserialize("named", namedRead);
+            reader.Deserialize("labels", labelsRead);
+            reader.Deserialize("weights", weightsRead);
+
+            assert(countsRead == counts && labelsRead == labels && weightsRead == weights);
+            assert(namedRead.size() == 2 && namedRead["first"].x == 1 && namedRead["first"].y == 2 && namedRead["second"].x == 3 && namedRead["second"].y == 4);
+        };
+        ForEachSerializer(roundTrip);
+
+        //String keys are the fields of an object, any other key makes an array of pairs
+        JsonSerializer json;
+        json.Serialize("counts", counts);
+        json.Serialize("labels", labels);
+        assert(json.Data()["counts"]["pears"] == -7);
+        assert(json.Data()["labels"].is_array() && json.Data()["labels"][1]["key"] == 12 && json.Data()["labels"][1]["value"] == "twelve");
+
+        //A field of the wrong type leaves the map as it was
+        std::map<std::string, int> kept{ { "kept", 1 } };
+        bool threw = false;
+        try { json.Deserialize("labels", kept); } catch(const std::runtime_error&) { threw = true; }
+        assert(threw && kept.size() == 1 && kept["kept"] == 1);
+
+        //Unordered maps are sized for all their entries before any goes in
+        std::unordered_map<std::uint64_t, double> reserved;
+        BinarySerializer binary(BinarySerializer::Mode::Positional);
+        binary.Serialize("weights", weights);
+        binary.Deserialize("weights", reserved);
+        assert(reserved == weights && reserved.bucket_count() >= std::size_t(weights.size() / reserved.max_load_factor()));
+    }
+
+    {
+        //std::string, std::string_view and C strings are all written as strings, and read back into a std::string
+        std::string text("with an embedded \0 and more", 28);
+        std::string_view sentence = "not terminated where the view ends";
+        const char* cString = "c string";
+
+        auto roundTrip = [&](auto writer, auto reopen)
+        {
+            //Strings only read back into a std::string, C strings never go to the single char pointer overload
+            static_assert(!CanDeserialize<decltype(writer), char*>::value && !CanDeserialize<decltype(writer), const char*>::value);
+
+            writer.Serialize("text", text);
+            writer.Serialize("view", sentence.substr(0, 14));
+            writer.Serialize("cString", cString);
+            writer.Serialize("literal", "literal");
+            writer.Serialize("empty", std::string());
+
+            auto reader = reopen(writer);
+            std::string textRead, viewRead, literalRead;
+            std::string emptyRead = "stale";
+
+            //Read in place, a string with room for the value keeps its buffer
+            std::string reused(64, 'x');
+            const char* buffer = reused.data();
+
+            reader.Deserialize("text", textRead);
+            reader.Deserialize("view", viewRead);
+            reader.Deserialize("cString", reused);
+            reader.Deserialize("literal", literalRead);
+            reader.Deserialize("empty", emptyRead);
+
+            assert(textRead == text && viewRead == "not terminated" && literalRead == "literal" && emptyRead.empty());
+            assert(reused == cString && reused.data() == buffer);
+        };
+        ForEachSerializer(roundTrip);
+
+        JsonSerializer json;
+        json.Serialize("literal", "literal");
+        json.Serialize("number", 5);
+        assert(json.Data()["literal"] == "literal");
+
+        bool threw = false;
+        try
+        {
+            std::string number;
+            json.Deserialize("number", number);
+        }
+        catch(const std::runtime_error&)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        threw = false;
+        try
+        {
+            const char* null = nullptr;
+            json.Serialize("null", null);
+        }
+        catch(const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        assert(threw);
     }
 
 